@@ -0,0 +1,171 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "alloccount.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace rcgv
+{
+
+namespace
+{
+
+std::atomic<uint64_t> alloc_count(0);
+thread_local uint64_t thread_alloc_count=0;
+
+#ifdef RCGV_COUNT_ALLOCATIONS
+
+void *allocate(size_t size, bool nothrow)
+{
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  thread_alloc_count++;
+
+  if (size == 0)
+  {
+    size=1;
+  }
+
+  while (true)
+  {
+    void *p=std::malloc(size);
+
+    if (p != 0)
+    {
+      return p;
+    }
+
+    std::new_handler handler=std::get_new_handler();
+
+    if (handler == 0)
+    {
+      if (nothrow)
+      {
+        return 0;
+      }
+
+      throw std::bad_alloc();
+    }
+
+    try
+    {
+      handler();
+    }
+    catch (const std::bad_alloc &)
+    {
+      if (nothrow)
+      {
+        return 0;
+      }
+
+      throw;
+    }
+  }
+}
+
+#endif
+
+}
+
+bool isAllocationCounting()
+{
+#ifdef RCGV_COUNT_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint64_t getAllocationCount()
+{
+  return alloc_count.load(std::memory_order_relaxed);
+}
+
+uint64_t getThreadAllocationCount()
+{
+  return thread_alloc_count;
+}
+
+}
+
+#ifdef RCGV_COUNT_ALLOCATIONS
+
+/*
+  Replacements of the global allocation functions that count all allocations.
+*/
+
+void *operator new(size_t size)
+{
+  return rcgv::allocate(size, false);
+}
+
+void *operator new[](size_t size)
+{
+  return rcgv::allocate(size, false);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  return rcgv::allocate(size, true);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+  return rcgv::allocate(size, true);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+  std::free(p);
+}
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "convert.h"
+
+#include <rc_genicam_api/pixel_formats.h>
+
+#include <gutil/proctime.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Measures the time for converting disparity and color images with all" << std::endl;
+  std::cout << "instruction set extensions that are supported by the CPU." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h              Shows this help and exits." << std::endl;
+  std::cout << "-size <w>x<h>   Size of the synthetic images. Default is 1280x960." << std::endl;
+  std::cout << "-n <n>          Number of repetitions. Default is 50." << std::endl;
+}
+
+const char *getSIMDName(rcgv::SIMDLevel level)
+{
+  switch (level)
+  {
+    case rcgv::SIMD_SSE2:
+      return "SSE2";
+
+    case rcgv::SIMD_SSSE3:
+      return "SSSE3";
+
+    case rcgv::SIMD_AVX2:
+      return "AVX2";
+
+    default:
+      return "scalar";
+  }
+}
+
+/*
+  Converts a synthetic raw image with the given pixel format into planar
+  output. The output is only resized if necessary.
+*/
+
+void convert(std::vector<uint8_t> &ret, const std::vector<uint8_t> &raw, size_t width,
+             size_t height, const std::string &format)
+{
+  if (format == "Disparity")
+  {
+    ret.resize(width*height*sizeof(uint16_t));
+    uint16_t *out=reinterpret_cast<uint16_t *>(&ret[0]);
+
+    for (size_t k=0; k<height; k++)
+    {
+      rcgv::decodeDisparityRow(out+k*width, &raw[k*2*width], width, k&1, 0);
+    }
+  }
+  else if (format == "RGB8")
+  {
+    ret.resize(3*width*height);
+    uint8_t *r=&ret[0];
+    uint8_t *g=r+width*height;
+    uint8_t *b=g+width*height;
+
+    for (size_t k=0; k<height; k++)
+    {
+      rcgv::convertRGB8Row(r+k*width, g+k*width, b+k*width, &raw[k*3*width], width);
+    }
+  }
+  else if (format == "YCbCr411_8")
+  {
+    ret.resize(3*width*height);
+    uint8_t *r=&ret[0];
+    uint8_t *g=r+width*height;
+    uint8_t *b=g+width*height;
+
+    for (size_t k=0; k<height; k++)
+    {
+      rcgv::convertYCbCr411Row(r+k*width, g+k*width, b+k*width, &raw[k*width/4*6], width);
+    }
+  }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  size_t width=1280;
+  size_t height=960;
+  int n=50;
+
+  int i=1;
+  while (i < argc)
+  {
+    std::string p=argv[i++];
+
+    if (p == "-h")
+    {
+      printHelp(argv[0]);
+      return 0;
+    }
+    else if (p == "-size" && i < argc)
+    {
+      std::string s=argv[i++];
+      size_t j=s.find('x');
+
+      if (j == std::string::npos)
+      {
+        std::cerr << "Size must be given as <w>x<h>: " << s << std::endl;
+        return 1;
+      }
+
+      width=static_cast<size_t>(std::stoi(s.substr(0, j)));
+      height=static_cast<size_t>(std::stoi(s.substr(j+1)));
+    }
+    else if (p == "-n" && i < argc)
+    {
+      n=std::max(1, std::stoi(argv[i++]));
+    }
+    else
+    {
+      std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+      return 1;
+    }
+  }
+
+  width&=~static_cast<size_t>(3);
+
+  if (width == 0 || height == 0)
+  {
+    std::cerr << "Image size must not be 0" << std::endl;
+    return 1;
+  }
+
+  // create random raw data that is large enough for all formats
+
+  std::vector<uint8_t> raw(3*width*height);
+
+  srand(1);
+  for (size_t j=0; j<raw.size(); j++)
+  {
+    raw[j]=static_cast<uint8_t>(rand()&0xff);
+  }
+
+  // measure all formats with all supported instruction set extensions
+
+  const char *format[]={"Disparity", "RGB8", "YCbCr411_8"};
+
+  std::cout << "Image size: " << width << "x" << height << ", repetitions: " << n << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Format" << std::setw(8) << "SIMD" <<
+    std::right << std::setw(12) << "ns/pixel" << std::setw(10) << "speedup" << "  result" <<
+    std::endl;
+
+  int ret=0;
+  for (int f=0; f<3; f++)
+  {
+    double tscalar=0;
+    std::vector<uint8_t> reference;
+
+    for (int l=rcgv::SIMD_NONE; l<=rcgv::getSupportedSIMDLevel(); l++)
+    {
+      rcgv::setSIMDLevel(static_cast<rcgv::SIMDLevel>(l));
+
+      std::vector<uint8_t> out;
+      convert(out, raw, width, height, format[f]);
+
+      double t=gutil::ProcTime::monotonic();
+
+      for (int j=0; j<n; j++)
+      {
+        convert(out, raw, width, height, format[f]);
+      }
+
+      t=(gutil::ProcTime::monotonic()-t)/n;
+
+      if (l == rcgv::SIMD_NONE)
+      {
+        tscalar=t;
+        reference=out;
+      }
+
+      bool same=(out == reference);
+
+      if (!same)
+      {
+        ret=1;
+      }
+
+      std::cout << std::left << std::setw(12) << format[f] <<
+        std::setw(8) << getSIMDName(static_cast<rcgv::SIMDLevel>(l)) << std::right <<
+        std::setw(12) << std::fixed << std::setprecision(3) << 1e9*t/(width*height) <<
+        std::setw(10) << std::setprecision(2) << tscalar/t <<
+        (same ? "  ok" : "  DIFFERENT") << std::endl;
+    }
+  }
+
+  return ret;
+}
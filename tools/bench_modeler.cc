@@ -0,0 +1,721 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "modeler.h"
+#include "rawimage.h"
+
+#include <rc_genicam_api/pixel_formats.h>
+
+#include <gvr/pointcloud.h>
+#include <gutil/proctime.h>
+#include <gutil/exception.h>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options> [<left> <disp> ...]" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Measures the performance of the modeler without device and without window." << std::endl;
+  std::cout << "Synthetic input is created for all given sizes, pixel formats and byte" << std::endl;
+  std::cout << "orders, unless pairs of recorded left and disparity images are given. The" << std::endl;
+  std::cout << "left image can be an 8 bit PGM or PPM file and the disparity image must be a" << std::endl;
+  std::cout << "16 bit PGM file." << std::endl;
+  std::cout << std::endl;
+  std::cout << "The output can be stored and used as baseline for later runs." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h                Shows this help and exits." << std::endl;
+  std::cout << "-size <w>x<h>,... Sizes of synthetic disparity images. Default is" << std::endl;
+  std::cout << "                  1280x960,640x480,320x240,214x160. The left image is scaled" << std::endl;
+  std::cout << "                  up to a width of about 1280 pixels." << std::endl;
+  std::cout << "-format <f>,...   Pixel formats of synthetic left images. Default is" << std::endl;
+  std::cout << "                  Mono8,RGB8,YCbCr411_8." << std::endl;
+  std::cout << "-endian <e>,...   Byte order of synthetic disparity images, i.e. little or" << std::endl;
+  std::cout << "                  big. Default is little,big." << std::endl;
+  std::cout << "-threads <n>      Number of threads for meshing. Default is 0 for all cores." << std::endl;
+  std::cout << "-n <n>            Number of measured frames. Default is 50." << std::endl;
+  std::cout << "-rep <n>          Number of repetitions of each configuration. The" << std::endl;
+  std::cout << "                  repetition with the median framerate is reported." << std::endl;
+  std::cout << "                  Default is 5." << std::endl;
+  std::cout << "-warmup <n>       Number of frames before measuring. Default is 5." << std::endl;
+  std::cout << "-f <f>            Focal length factor. Default is 1.08." << std::endl;
+  std::cout << "-t <t>            Baseline in meter. Default is 0.065." << std::endl;
+  std::cout << "-scale <s>        Disparity scale factor. Default is 0.0625." << std::endl;
+  std::cout << "-inv <v>          Raw value of invalid disparities. Default is 0." << std::endl;
+  std::cout << "-baseline <file>  Compares the results with the stored output of a" << std::endl;
+  std::cout << "                  previous run and returns 1 if a configuration became" << std::endl;
+  std::cout << "                  slower than the tolerance or needs more allocations." << std::endl;
+  std::cout << "-tol <x>          Minimal tolerance for comparing with the baseline. It is" << std::endl;
+  std::cout << "                  increased to three times the sum of the spreads of the" << std::endl;
+  std::cout << "                  framerate of both runs. Default is 0.2." << std::endl;
+  std::cout << std::endl;
+  std::cout << "The column spread is the median absolute deviation of the framerate of all" << std::endl;
+  std::cout << "repetitions relative to the median." << std::endl;
+  std::cout << std::endl;
+  std::cout << "The column mesh_alloc counts the heap allocations per frame that cvkit makes" << std::endl;
+  std::cout << "for the vertex, color, normal and triangle lists of the pooled meshes." << std::endl;
+  std::cout << "The column alloc/frame counts all other allocations of the pipeline, which" << std::endl;
+  std::cout << "should be 0 after warm-up." << std::endl;
+}
+
+std::vector<std::string> split(const std::string &s, char sep)
+{
+  std::vector<std::string> ret;
+  std::istringstream in(s);
+  std::string item;
+
+  while (std::getline(in, item, sep))
+  {
+    if (item.size() > 0)
+    {
+      ret.push_back(item);
+    }
+  }
+
+  return ret;
+}
+
+uint64_t getFormat(const std::string &name)
+{
+  if (name == "Mono8") return Mono8;
+  if (name == "RGB8") return RGB8;
+  if (name == "YCbCr411_8") return YCbCr411_8;
+
+  throw gutil::InvalidArgumentException("Unknown pixel format: "+name);
+}
+
+/*
+  Creates a synthetic disparity image of a smooth surface with noise and
+  invalid regions. The disparity range corresponds to distances of about 0.5
+  to 2 m of an rc_visard.
+*/
+
+std::shared_ptr<rcgv::RawImage> createDisparity(size_t width, size_t height, bool bigendian,
+                                                double scale, int inv, int seed)
+{
+  std::shared_ptr<rcgv::RawImage> ret=std::make_shared<rcgv::RawImage>(width, height, Mono16,
+    bigendian);
+
+  uint8_t *p=ret->getData();
+  srand(static_cast<unsigned int>(seed));
+
+  double dbase=80.0*width/1280;
+  double phase=0.5*seed;
+
+  for (size_t k=0; k<height; k++)
+  {
+    for (size_t i=0; i<width; i++)
+    {
+      double x=static_cast<double>(i)/width;
+      double y=static_cast<double>(k)/height;
+
+      double d=dbase*(1+0.5*std::sin(6.0*x+phase)*std::cos(4.0*y)+0.3*y);
+      d+=0.2*dbase*((rand()&0xff)/255.0-0.5)/8;
+
+      int v=static_cast<int>(d/scale+0.5);
+
+      // sparse invalid pixels and an invalid block
+
+      if ((rand()&0x1f) == 0 || (x > 0.4 && x < 0.5 && y > 0.2 && y < 0.4))
+      {
+        v=inv;
+      }
+
+      v=std::max(0, std::min(0xffff, v));
+
+      if (bigendian)
+      {
+        *p++=static_cast<uint8_t>(v>>8);
+        *p++=static_cast<uint8_t>(v&0xff);
+      }
+      else
+      {
+        *p++=static_cast<uint8_t>(v&0xff);
+        *p++=static_cast<uint8_t>(v>>8);
+      }
+    }
+  }
+
+  return ret;
+}
+
+/*
+  Creates a synthetic left image with random content.
+*/
+
+std::shared_ptr<rcgv::RawImage> createLeft(size_t width, size_t height, uint64_t format,
+                                           int seed)
+{
+  std::shared_ptr<rcgv::RawImage> ret=std::make_shared<rcgv::RawImage>(width, height, format);
+
+  uint8_t *p=ret->getData();
+  size_t n=rcgv::RawImage::getLineSize(width, format)*height;
+
+  srand(static_cast<unsigned int>(seed));
+
+  for (size_t i=0; i<n; i++)
+  {
+    p[i]=static_cast<uint8_t>(rand()&0xff);
+  }
+
+  return ret;
+}
+
+/*
+  Loads an 8 bit PGM or PPM image or a 16 bit PGM image, which stores values
+  in big endian.
+*/
+
+std::shared_ptr<rcgv::RawImage> loadPNM(const std::string &name)
+{
+  std::ifstream in(name.c_str(), std::ios::binary);
+
+  if (!in.good())
+  {
+    throw gutil::IOException("Cannot open file: "+name);
+  }
+
+  std::string magic;
+  long v[3];
+
+  in >> magic;
+
+  for (int j=0; j<3; j++)
+  {
+    // skip comments
+
+    in >> std::ws;
+    while (in.peek() == '#')
+    {
+      std::string line;
+      std::getline(in, line);
+      in >> std::ws;
+    }
+
+    in >> v[j];
+  }
+
+  in.get();
+
+  if (!in.good() || (magic != "P5" && magic != "P6") || v[0] <= 0 || v[1] <= 0 ||
+    v[2] <= 0 || v[2] > 0xffff || (magic == "P6" && v[2] > 0xff))
+  {
+    throw gutil::IOException("Unsupported image file: "+name);
+  }
+
+  uint64_t format=Mono8;
+
+  if (magic == "P6")
+  {
+    format=RGB8;
+  }
+  else if (v[2] > 0xff)
+  {
+    format=Mono16;
+  }
+
+  std::shared_ptr<rcgv::RawImage> ret=std::make_shared<rcgv::RawImage>(
+    static_cast<size_t>(v[0]), static_cast<size_t>(v[1]), format, format == Mono16);
+
+  size_t n=rcgv::RawImage::getLineSize(ret->getWidth(), format)*ret->getHeight();
+  in.read(reinterpret_cast<char *>(ret->getData()), static_cast<std::streamsize>(n));
+
+  if (static_cast<size_t>(in.gcount()) != n)
+  {
+    throw gutil::IOException("Unexpected end of file: "+name);
+  }
+
+  return ret;
+}
+
+struct Frame
+{
+  std::shared_ptr<const rcgv::RawImage> left;
+  std::shared_ptr<const rcgv::RawImage> disp;
+};
+
+struct Result
+{
+  double fps;
+  double spread;        // relative median absolute deviation of fps
+  double mpoints;       // million points per second
+  double stage_ms[8];   // processing time per frame of each stage
+  double alloc;         // heap allocations per frame
+  double mesh_alloc;    // heap allocations per frame inside the meshes
+};
+
+/*
+  Polls models in a background thread until the given number of models has
+  been received.
+*/
+
+void receiveModels(rcgv::Modeler &modeler, int n, std::atomic<int> &count,
+                   std::atomic<uint64_t> &points)
+{
+  while (count < n)
+  {
+    std::shared_ptr<gvr::Model> model=modeler.nextModel();
+
+    if (model)
+    {
+      gvr::PointCloud *cloud=dynamic_cast<gvr::PointCloud *>(model.get());
+
+      if (cloud != 0)
+      {
+        points+=static_cast<uint64_t>(cloud->getVertexCount());
+      }
+
+      count++;
+    }
+    else
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+}
+
+/*
+  Processes all given frames repeatedly and returns the measured performance.
+*/
+
+Result measure(std::vector<std::string> &stage, const std::vector<Frame> &frame, int threads,
+               int warmup, int n, double f, double t, int inv, double scale)
+{
+  rcgv::Modeler modeler(threads, true);
+
+  std::atomic<int> count(0);
+  std::atomic<uint64_t> points(0);
+
+  // warm up pools and lookup tables
+
+  {
+    std::thread receiver(receiveModels, std::ref(modeler), warmup, std::ref(count),
+      std::ref(points));
+
+    for (int i=0; i<warmup; i++)
+    {
+      const Frame &fr=frame[static_cast<size_t>(i)%frame.size()];
+      modeler.process(f, t, inv, scale, 0, fr.left, fr.disp);
+    }
+
+    receiver.join();
+  }
+
+  count=0;
+  points=0;
+
+  std::vector<double> occupancy;
+  modeler.getStageOccupancy(stage, occupancy);
+  uint64_t alloc=modeler.getAllocationCount();
+  uint64_t mesh_alloc=modeler.getMeshAllocationCount();
+
+  // measure
+
+  double t0=gutil::ProcTime::monotonic();
+
+  std::thread receiver(receiveModels, std::ref(modeler), n, std::ref(count),
+    std::ref(points));
+
+  for (int i=0; i<n; i++)
+  {
+    const Frame &fr=frame[static_cast<size_t>(i)%frame.size()];
+    modeler.process(f, t, inv, scale, 0, fr.left, fr.disp);
+  }
+
+  receiver.join();
+
+  double t1=gutil::ProcTime::monotonic();
+
+  modeler.getStageOccupancy(stage, occupancy);
+
+  Result ret;
+
+  ret.fps=n/(t1-t0);
+  ret.mpoints=points/(t1-t0)/1e6;
+  ret.alloc=static_cast<double>(modeler.getAllocationCount()-alloc)/n;
+  ret.mesh_alloc=static_cast<double>(modeler.getMeshAllocationCount()-mesh_alloc)/n;
+
+  for (size_t i=0; i<occupancy.size() && i < 8; i++)
+  {
+    ret.stage_ms[i]=1000*occupancy[i]*(t1-t0)/n;
+  }
+
+  return ret;
+}
+
+/*
+  Repeats the measurement and returns the result of the repetition with the
+  median framerate, together with the spread of the framerate.
+*/
+
+Result measureMedian(std::vector<std::string> &stage, const std::vector<Frame> &frame,
+                     int threads, int warmup, int n, int rep, double f, double t, int inv,
+                     double scale)
+{
+  std::vector<Result> list;
+
+  for (int i=0; i<rep; i++)
+  {
+    list.push_back(measure(stage, frame, threads, warmup, n, f, t, inv, scale));
+  }
+
+  std::sort(list.begin(), list.end(), [](const Result &a, const Result &b)
+  {
+    return a.fps < b.fps;
+  });
+
+  Result ret=list[list.size()/2];
+
+  std::vector<double> dev;
+  for (size_t i=0; i<list.size(); i++)
+  {
+    dev.push_back(std::abs(list[i].fps-ret.fps));
+  }
+
+  std::sort(dev.begin(), dev.end());
+
+  ret.spread=dev[dev.size()/2]/std::max(1e-6, ret.fps);
+
+  return ret;
+}
+
+/*
+  Reads the results of a previous run. Comments start with '#'. Each line
+  starts with the name of the configuration, followed by frames per second,
+  spread of frames per second, million points per second, stage times, allocations inside the meshes and
+  allocations of the pipeline per frame.
+*/
+
+std::map<std::string, Result> loadBaseline(const std::string &name)
+{
+  std::map<std::string, Result> ret;
+  std::ifstream in(name.c_str());
+
+  if (!in.good())
+  {
+    throw gutil::IOException("Cannot open file: "+name);
+  }
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    // remove comments
+
+    line=line.substr(0, line.find('#'));
+
+    std::vector<std::string> list=split(line, ' ');
+
+    if (list.size() >= 6)
+    {
+      Result r;
+
+      r.fps=std::atof(list[1].c_str());
+      r.spread=std::atof(list[2].c_str());
+      r.mpoints=std::atof(list[3].c_str());
+      r.mesh_alloc=std::atof(list[list.size()-2].c_str());
+      r.alloc=std::atof(list.back().c_str());
+
+      ret[list[0]]=r;
+    }
+  }
+
+  return ret;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::vector<std::string> size=split("1280x960,640x480,320x240,214x160", ',');
+    std::vector<std::string> format=split("Mono8,RGB8,YCbCr411_8", ',');
+    std::vector<std::string> endian=split("little,big", ',');
+    std::vector<std::string> recorded;
+    std::string baseline;
+    int threads=0;
+    int n=50;
+    int rep=5;
+    int warmup=5;
+    double f=1.08;
+    double t=0.065;
+    double scale=0.0625;
+    int inv=0;
+    double tol=0.2;
+
+    int i=1;
+    while (i < argc)
+    {
+      std::string p=argv[i++];
+
+      if (p == "-h")
+      {
+        printHelp(argv[0]);
+        return 0;
+      }
+      else if (p == "-size" && i < argc)
+      {
+        size=split(argv[i++], ',');
+      }
+      else if (p == "-format" && i < argc)
+      {
+        format=split(argv[i++], ',');
+      }
+      else if (p == "-endian" && i < argc)
+      {
+        endian=split(argv[i++], ',');
+      }
+      else if (p == "-threads" && i < argc)
+      {
+        threads=std::max(0, std::stoi(argv[i++]));
+      }
+      else if (p == "-n" && i < argc)
+      {
+        n=std::max(1, std::stoi(argv[i++]));
+      }
+      else if (p == "-rep" && i < argc)
+      {
+        rep=std::max(1, std::stoi(argv[i++]));
+      }
+      else if (p == "-warmup" && i < argc)
+      {
+        warmup=std::max(0, std::stoi(argv[i++]));
+      }
+      else if (p == "-f" && i < argc)
+      {
+        f=std::stod(argv[i++]);
+      }
+      else if (p == "-t" && i < argc)
+      {
+        t=std::stod(argv[i++]);
+      }
+      else if (p == "-scale" && i < argc)
+      {
+        scale=std::stod(argv[i++]);
+      }
+      else if (p == "-inv" && i < argc)
+      {
+        inv=std::stoi(argv[i++]);
+      }
+      else if (p == "-baseline" && i < argc)
+      {
+        baseline=argv[i++];
+      }
+      else if (p == "-tol" && i < argc)
+      {
+        tol=std::stod(argv[i++]);
+      }
+      else if (p.size() > 0 && p[0] != '-')
+      {
+        recorded.push_back(p);
+      }
+      else
+      {
+        std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+        return 1;
+      }
+    }
+
+    if (recorded.size()%2 != 0)
+    {
+      std::cerr << "Recorded images must be given as pairs of left and disparity images" <<
+        std::endl;
+      return 1;
+    }
+
+    // create list of configurations with their input frames
+
+    std::vector<std::string> config;
+    std::vector<std::vector<Frame> > input;
+
+    if (recorded.size() > 0)
+    {
+      config.push_back("recorded");
+      input.push_back(std::vector<Frame>());
+
+      for (size_t j=0; j<recorded.size(); j+=2)
+      {
+        Frame fr;
+        fr.left=loadPNM(recorded[j]);
+        fr.disp=loadPNM(recorded[j+1]);
+
+        if (fr.disp->getPixelFormat() != Mono16)
+        {
+          throw gutil::IOException("Disparity image must have 16 bit: "+recorded[j+1]);
+        }
+
+        input.back().push_back(fr);
+      }
+    }
+    else
+    {
+      for (size_t s=0; s<size.size(); s++)
+      {
+        std::vector<std::string> wh=split(size[s], 'x');
+
+        if (wh.size() != 2 || std::stoi(wh[0]) <= 0 || std::stoi(wh[1]) <= 0)
+        {
+          std::cerr << "Size must be given as <w>x<h>: " << size[s] << std::endl;
+          return 1;
+        }
+
+        size_t width=static_cast<size_t>(std::stoi(wh[0]));
+        size_t height=static_cast<size_t>(std::stoi(wh[1]));
+        size_t ds=std::max(static_cast<size_t>(1), (1280+width/2)/width);
+
+        for (size_t c=0; c<format.size(); c++)
+        {
+          uint64_t fmt=getFormat(format[c]);
+
+          for (size_t e=0; e<endian.size(); e++)
+          {
+            bool bigendian=(endian[e] == "big");
+
+            config.push_back(size[s]+"/"+format[c]+"/"+endian[e]);
+            input.push_back(std::vector<Frame>());
+
+            for (int j=0; j<4; j++)
+            {
+              Frame fr;
+              fr.left=createLeft(width*ds, height*ds, fmt, j);
+              fr.disp=createDisparity(width, height, bigendian, scale, inv, j);
+              input.back().push_back(fr);
+            }
+          }
+        }
+      }
+    }
+
+    std::map<std::string, Result> base;
+    if (baseline.size() > 0)
+    {
+      base=loadBaseline(baseline);
+    }
+
+    // measure all configurations
+
+    std::cout << "# threads: " << threads << ", frames: " << n << ", repetitions: " << rep <<
+      ", warmup: " << warmup << std::endl;
+
+    int ret=0;
+    for (size_t j=0; j<config.size(); j++)
+    {
+      std::vector<std::string> stage;
+      Result r=measureMedian(stage, input[j], threads, warmup, n, rep, f, t, inv, scale);
+
+      if (j == 0)
+      {
+        std::cout << "# " << std::left << std::setw(30) << "config" << std::right <<
+          std::setw(9) << "fps" << std::setw(8) << "spread" << std::setw(11) << "Mpoints/s";
+
+        for (size_t k=0; k<stage.size(); k++)
+        {
+          std::cout << std::setw(11) << (stage[k]+"_ms");
+        }
+
+        std::cout << std::setw(11) << "mesh_alloc" << std::setw(13) << "alloc/frame" <<
+          std::endl;
+      }
+
+      std::cout << std::left << std::setw(32) << config[j] << std::right << std::fixed <<
+        std::setprecision(2) << std::setw(9) << r.fps << std::setprecision(3) << std::setw(8) <<
+        r.spread << std::setprecision(2) << std::setw(11) << r.mpoints <<
+        std::setprecision(3);
+
+      for (size_t k=0; k<stage.size() && k < 8; k++)
+      {
+        std::cout << std::setw(11) << r.stage_ms[k];
+      }
+
+      std::cout << std::setprecision(2) << std::setw(11) << r.mesh_alloc << std::setw(13) <<
+        r.alloc;
+
+      // compare with baseline
+
+      std::map<std::string, Result>::const_iterator it=base.find(config[j]);
+      if (it != base.end())
+      {
+        // the tolerance covers the measured variation of both runs
+
+        double rel=r.fps/std::max(1e-6, it->second.fps);
+        double rtol=std::max(tol, 3*(r.spread+it->second.spread));
+
+        std::cout << "  # " << std::setprecision(2) << rel << "x";
+
+        if (rel < 1-rtol)
+        {
+          std::cout << " SLOWER";
+          ret=1;
+        }
+
+        if (r.alloc > it->second.alloc+0.5)
+        {
+          std::cout << " MORE ALLOCATIONS";
+          ret=1;
+        }
+      }
+
+      std::cout << std::endl;
+    }
+
+    return ret;
+  }
+  catch (const std::exception &ex)
+  {
+    std::cerr << ex.what() << std::endl;
+  }
+
+  return 1;
+}
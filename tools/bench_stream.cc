@@ -0,0 +1,490 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamserver.h"
+#include "streamclient.h"
+
+#include <gvr/coloredmesh.h>
+#include <gutil/proctime.h>
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Measures throughput and bytes per frame of streaming point clouds to a client" << std::endl;
+  std::cout << "over the loopback interface for all encodings. The client decodes all frames" << std::endl;
+  std::cout << "and checks the quantization error." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h              Shows this help and exits." << std::endl;
+  std::cout << "-enc <e>        Only measures the given encoding, e.g. rgb565+delta." << std::endl;
+  std::cout << "-size <w>x<h>   Size of the synthetic organized point cloud. Default is" << std::endl;
+  std::cout << "                1280x960." << std::endl;
+  std::cout << "-n <n>          Number of frames. Default is 100." << std::endl;
+  std::cout << "-unix           Uses a Unix domain socket instead of TCP." << std::endl;
+  std::cout << "-slow           Measures each encoding again with a second client that takes" << std::endl;
+  std::cout << "                100 ms per frame, which must not slow down the first client." << std::endl;
+  std::cout << std::endl;
+  std::cout << "The program returns 1 if a frame cannot be decoded or has a too large error." << std::endl;
+  std::cout << "With -slow, it also returns 1 if the first client receives less than half of" << std::endl;
+  std::cout << "the frames per second or misses more than n/5 frames more than without the" << std::endl;
+  std::cout << "slow client." << std::endl;
+}
+
+/*
+  Creates a smooth surface with some invalid regions, with points in the
+  order of the rows of a disparity image, like the modeler does.
+*/
+
+std::shared_ptr<gvr::ColoredMesh> createMesh(int width, int height)
+{
+  const double f=0.8*width;
+
+  std::vector<float> xyz;
+  std::vector<uint8_t> rgb;
+
+  for (int k=0; k<height; k++)
+  {
+    for (int i=0; i<width; i++)
+    {
+      // leave out some blobs, like areas without disparity
+
+      if (std::sin(0.05*i)*std::sin(0.07*k) > 0.8)
+      {
+        continue;
+      }
+
+      double z=1.0+0.2*std::sin(0.01*i)*std::cos(0.013*k)+(i > width/2 ? 0.3 : 0);
+      xyz.push_back(static_cast<float>((i-width/2.0)*z/f));
+      xyz.push_back(static_cast<float>((k-height/2.0)*z/f));
+      xyz.push_back(static_cast<float>(z));
+
+      rgb.push_back(static_cast<uint8_t>(i*255/width));
+      rgb.push_back(static_cast<uint8_t>(k*255/height));
+      rgb.push_back(static_cast<uint8_t>((i+k)&0xff));
+    }
+  }
+
+  int n=static_cast<int>(xyz.size()/3);
+
+  std::shared_ptr<gvr::ColoredMesh> mesh=std::make_shared<gvr::ColoredMesh>();
+  mesh->resizeVertexList(n, false, false);
+  mesh->resizeTriangleList(0);
+
+  for (int i=0; i<n; i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      mesh->setVertexComp(i, k, xyz[3*i+k]);
+      mesh->setColorComp(i, k, rgb[3*i+k]);
+    }
+  }
+
+  return mesh;
+}
+
+struct ClientResult
+{
+  ClientResult() : frames(0), last(0), bytes(0), missed(0), error(0), failed(false),
+    tlast(0) { }
+
+  long frames;
+  std::atomic<uint64_t> last;
+  double bytes;
+  uint64_t missed;
+  double error;
+  bool failed;
+  double tlast;
+};
+
+/*
+  Receives and decodes frames until the connection is closed. The error of
+  the first frame is computed against the original points.
+*/
+
+void receive(const std::string &address, const gvr::ColoredMesh *mesh, double delay,
+             std::atomic<int> *connected, ClientResult *res)
+{
+  rcgv::StreamClient client;
+
+  if (!client.connect(address))
+  {
+    res->failed=true;
+    connected->fetch_add(1);
+    return;
+  }
+
+  connected->fetch_add(1);
+
+  std::vector<uint8_t> data;
+  rcgv::StreamFrame frame;
+
+  while (client.receive(data))
+  {
+    if (!rcgv::decodeFrame(frame, data.data(), data.size()) ||
+        frame.count != static_cast<size_t>(mesh->getVertexCount()))
+    {
+      res->failed=true;
+      break;
+    }
+
+    if (res->frames == 0)
+    {
+      for (size_t i=0; i<frame.count; i++)
+      {
+        for (int k=0; k<3; k++)
+        {
+          double e=std::abs(frame.xyz[3*i+k]-mesh->getVertexComp(static_cast<int>(i), k));
+          res->error=std::max(res->error, e);
+        }
+      }
+    }
+
+    if (res->last > 0 && frame.number > res->last+1)
+    {
+      res->missed+=frame.number-res->last-1;
+    }
+
+    res->frames++;
+    res->bytes+=data.size();
+    res->tlast=gutil::ProcTime::monotonic();
+    res->last=frame.number;
+
+    if (delay > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(1000*delay)));
+    }
+  }
+}
+
+struct Measurement
+{
+  Measurement() : tstart(0), encode_time(0) { }
+
+  ClientResult res, slow_res;
+  double tstart;
+  double encode_time;
+};
+
+/*
+  Streams n frames to a fast and optionally to a slow client and waits
+  until both clients have finished.
+*/
+
+void measure(const std::string &address, int flags, const std::shared_ptr<gvr::ColoredMesh> &mesh,
+             int n, bool slow, Measurement &m)
+{
+  std::thread fast_thread, slow_thread;
+
+  {
+    rcgv::StreamServer server(address, flags, 2);
+
+    // connect clients and wait until the server has accepted them
+
+    std::atomic<int> connected(0);
+    int nclients=(slow ? 2 : 1);
+
+    fast_thread=std::thread(receive, server.getAddress(), mesh.get(), 0.0, &connected, &m.res);
+
+    if (slow)
+    {
+      slow_thread=std::thread(receive, server.getAddress(), mesh.get(), 0.1, &connected,
+        &m.slow_res);
+    }
+
+    while (connected.load() < nclients ||
+           server.getStatistics().clients < static_cast<uint64_t>(nclients))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // hand over the next frame as soon as the previous one has been
+    // encoded, which is faster than a device
+
+    m.tstart=gutil::ProcTime::monotonic();
+
+    rcgv::FrameInfo info;
+    for (int k=0; k<n; k++)
+    {
+      info.timestamp=static_cast<uint64_t>(k)*40000000;
+      server.add(mesh, info);
+
+      while (server.getStatistics().encoded < static_cast<uint64_t>(k+1))
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    // wait until the fast client has received the last frame, which is
+    // never dropped
+
+    rcgv::StreamServer::Statistics stat=server.getStatistics();
+    m.encode_time=stat.encode_time/stat.encoded;
+
+    double twait=gutil::ProcTime::monotonic();
+
+    while (m.res.last.load() < static_cast<uint64_t>(n) && !m.res.failed &&
+           gutil::ProcTime::monotonic() < twait+10)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  // destroying the server closes all connections, which ends the clients
+
+  fast_thread.join();
+
+  if (slow)
+  {
+    slow_thread.join();
+  }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<int> flags;
+  int width=1280, height=960;
+  int n=100;
+  bool unix_socket=false;
+  bool slow=false;
+
+  int i=1;
+  while (i < argc)
+  {
+    std::string p=argv[i++];
+
+    if (p == "-h")
+    {
+      printHelp(argv[0]);
+      return 0;
+    }
+    else if (p == "-enc" && i < argc)
+    {
+      int f=rcgv::getStreamFlags(argv[i++]);
+
+      if (f < 0)
+      {
+        std::cerr << "Unknown encoding: " << argv[i-1] << std::endl;
+        return 1;
+      }
+
+      flags.push_back(f);
+    }
+    else if (p == "-size" && i < argc)
+    {
+      std::string s=argv[i++];
+      size_t j=s.find('x');
+
+      if (j == std::string::npos)
+      {
+        std::cerr << "Size must be given as <w>x<h>: " << s << std::endl;
+        return 1;
+      }
+
+      width=std::max(1, std::stoi(s.substr(0, j)));
+      height=std::max(1, std::stoi(s.substr(j+1)));
+    }
+    else if (p == "-n" && i < argc)
+    {
+      n=std::max(1, std::stoi(argv[i++]));
+    }
+    else if (p == "-unix")
+    {
+      unix_socket=true;
+    }
+    else if (p == "-slow")
+    {
+      slow=true;
+    }
+    else
+    {
+      std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+      return 1;
+    }
+  }
+
+  if (flags.size() == 0)
+  {
+    const int all[]={rcgv::STREAM_COLOR_NONE, rcgv::STREAM_GRAY8, rcgv::STREAM_RGB565,
+      rcgv::STREAM_DELTA, rcgv::STREAM_GRAY8 | rcgv::STREAM_DELTA,
+      rcgv::STREAM_RGB565 | rcgv::STREAM_DELTA};
+
+    flags.assign(all, all+6);
+  }
+
+  std::shared_ptr<gvr::ColoredMesh> mesh=createMesh(width, height);
+  size_t points=static_cast<size_t>(mesh->getVertexCount());
+
+  // largest quantization step of all coordinates
+
+  double maxstep=0;
+  for (int k=0; k<3; k++)
+  {
+    double vmin=mesh->getVertexComp(0, k), vmax=vmin;
+
+    for (size_t j=1; j<points; j++)
+    {
+      vmin=std::min(vmin, static_cast<double>(mesh->getVertexComp(static_cast<int>(j), k)));
+      vmax=std::max(vmax, static_cast<double>(mesh->getVertexComp(static_cast<int>(j), k)));
+    }
+
+    maxstep=std::max(maxstep, (vmax-vmin)/65535);
+  }
+
+  std::cout << "Points per frame: " << points << ", raw size with float coordinates and RGB: " <<
+    points*15 << " bytes, frames: " << n << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Encoding" << std::right << std::setw(12) <<
+    "bytes/frame" << std::setw(10) << "bytes/pt" << std::setw(8) << "ratio" <<
+    std::setw(11) << "encode ms" << std::setw(9) << "frames/s" << std::setw(9) << "MB/s" <<
+    std::setw(11) << "error mm" << std::setw(8) << "missed";
+
+  if (slow)
+  {
+    std::cout << std::setw(9) << "ref f/s" << std::setw(12) << "ref missed" <<
+      std::setw(11) << "slow recv" << std::setw(13) << "slow missed";
+  }
+
+  std::cout << std::endl;
+
+  int ret=0;
+  for (size_t e=0; e<flags.size(); e++)
+  {
+    std::string address="0";
+
+    if (unix_socket)
+    {
+      std::ostringstream out;
+      out << "/tmp/bench_stream_" << getpid() << ".sock";
+      address=out.str();
+    }
+
+    // with a slow client, the measurement without it serves as reference
+
+    Measurement ref, m;
+
+    measure(address, flags[e], mesh, n, false, ref);
+
+    if (slow)
+    {
+      measure(address, flags[e], mesh, n, true, m);
+    }
+
+    const Measurement &mm=(slow ? m : ref);
+    const ClientResult &res=mm.res;
+
+    if (res.frames > 0)
+    {
+      double bpf=res.bytes/res.frames;
+      double fps=res.frames/(res.tlast-mm.tstart);
+
+      std::cout << std::left << std::setw(14) << rcgv::getStreamFlagsName(flags[e]) <<
+        std::right << std::fixed << std::setprecision(0) << std::setw(12) << bpf <<
+        std::setprecision(2) << std::setw(10) << bpf/points <<
+        std::setprecision(1) << std::setw(8) << 15.0*points/bpf <<
+        std::setprecision(2) << std::setw(11) << 1000*mm.encode_time <<
+        std::setprecision(1) << std::setw(9) << fps <<
+        std::setprecision(0) << std::setw(9) << fps*bpf/1e6 <<
+        std::setprecision(3) << std::setw(11) << 1000*res.error <<
+        std::setw(8) << res.missed;
+
+      if (slow)
+      {
+        double ref_fps=0;
+
+        if (ref.res.frames > 0)
+        {
+          ref_fps=ref.res.frames/(ref.res.tlast-ref.tstart);
+        }
+
+        std::cout << std::setprecision(1) << std::setw(9) << ref_fps <<
+          std::setw(12) << ref.res.missed << std::setw(11) << m.slow_res.frames <<
+          std::setw(13) << m.slow_res.missed;
+
+        // a slow client that blocks the server reduces the fast client to
+        // its rate, the margins only cover the variation between runs
+
+        if (fps < 0.5*ref_fps || res.missed > ref.res.missed+static_cast<uint64_t>(n/5))
+        {
+          std::cout << "  slowed down";
+          ret=1;
+        }
+      }
+
+      std::cout << std::endl;
+    }
+
+    if (res.failed || res.frames == 0 || ref.res.failed || ref.res.frames == 0)
+    {
+      std::cout << std::left << std::setw(14) << rcgv::getStreamFlagsName(flags[e]) <<
+        " failed" << std::endl;
+      ret=1;
+    }
+
+    // the error must be below half of the quantization step plus rounding of
+    // float values
+
+    if (std::max(res.error, ref.res.error) > 0.5*maxstep+1e-6)
+    {
+      std::cout << "Error of " << rcgv::getStreamFlagsName(flags[e]) <<
+        " is larger than half of the quantization step" << std::endl;
+      ret=1;
+    }
+  }
+
+  return ret;
+}
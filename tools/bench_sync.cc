@@ -0,0 +1,404 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simdevice.h"
+#include "framematcher.h"
+
+#include <gutil/proctime.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Measures the throughput and match rate of synchronizing intensity and disparity" << std::endl;
+  std::cout << "images from a simulated device under different conditions. The images are" << std::endl;
+  std::cout << "copied and paired by the same code as in the receiver. Without options, all" << std::endl;
+  std::cout << "scenarios are measured. Options are applied to all measured scenarios." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Scenarios are: ideal, multipart, jitter, reorder, incomplete, alternate, memory" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h              Shows this help and exits." << std::endl;
+  std::cout << "-scenario <s>   Only measures the given scenario." << std::endl;
+  std::cout << "-size <w>x<h>   Size of intensity images. Default is 1280x960." << std::endl;
+  std::cout << "-n <n>          Number of buffers. Default is 5000." << std::endl;
+  std::cout << "-multipart      Deliver intensity and disparity images in one buffer." << std::endl;
+  std::cout << "-latency <n>    Number of frames that disparity images are delivered later." << std::endl;
+  std::cout << "-jitter <ms>    Maximum deviation of timestamps of disparity images." << std::endl;
+  std::cout << "-tol <ms>       Tolerance for matching timestamps if the out1 mode is not" << std::endl;
+  std::cout << "                reported in the chunk data." << std::endl;
+  std::cout << "-nochunk        Do not report the out1 mode in the chunk data." << std::endl;
+  std::cout << "-reorder <p>    Probability of out of order delivery of a buffer." << std::endl;
+  std::cout << "-incomplete <p> Probability of incomplete buffers." << std::endl;
+  std::cout << "-drop <p>       Probability of losing an image." << std::endl;
+  std::cout << "-alternate      Simulates exposure alternate mode." << std::endl;
+  std::cout << "-maxmem <MB>    Maximum memory of images that wait for synchronization." << std::endl;
+  std::cout << std::endl;
+  std::cout << "The program returns 1 if images of different frames have been paired or if" << std::endl;
+  std::cout << "the memory scenario does not expire images or loses pairs." << std::endl;
+}
+
+struct Scenario
+{
+  Scenario() : tol(0), maxbytes(256*1024*1024), poolbytes(1024*1024*1024),
+    expiry(false) { }
+
+  std::string name;
+  rcgv::SimConfig config;
+  uint64_t tol;
+  size_t maxbytes;
+  size_t poolbytes;
+  bool expiry;          // true if images must be expired without losing pairs
+};
+
+std::vector<Scenario> getScenarios()
+{
+  std::vector<Scenario> ret;
+  Scenario s;
+
+  s.name="ideal";
+  s.tol=0;
+  ret.push_back(s);
+
+  s=Scenario();
+  s.name="multipart";
+  s.tol=0;
+  s.config.multipart=true;
+  ret.push_back(s);
+
+  s=Scenario();
+  s.name="jitter";
+  s.tol=1000000;
+  s.config.jitter=0.0005;
+  s.config.chunk=false;
+  ret.push_back(s);
+
+  s=Scenario();
+  s.name="reorder";
+  s.tol=0;
+  s.config.reorder=0.2;
+  ret.push_back(s);
+
+  s=Scenario();
+  s.name="incomplete";
+  s.tol=0;
+  s.config.incomplete=0.05;
+  s.config.drop=0.02;
+  ret.push_back(s);
+
+  s=Scenario();
+  s.name="alternate";
+  s.tol=0;
+  s.config.alternate=true;
+  ret.push_back(s);
+
+  // the budget covers the intensity images that wait for their disparity
+  // images, but not an additional image whose counterpart has been lost,
+  // which must be expired instead of an image that can still be paired
+
+  s=Scenario();
+  s.name="memory";
+  s.config.latency=8;
+  s.config.drop=0.05;
+  s.maxbytes=11*1024*1024;
+  s.expiry=true;
+  ret.push_back(s);
+
+  return ret;
+}
+
+struct Result
+{
+  uint64_t buffers;
+  uint64_t pairs;
+  uint64_t wrong;
+  uint64_t expected;
+  uint64_t orphaned;
+  uint64_t expired;
+  double tsync;
+  double ttotal;
+};
+
+/*
+  Gives the frame matcher access to the parts of a simulated buffer.
+*/
+
+class SimBufferParts: public rcgv::BufferParts
+{
+  public:
+
+    SimBufferParts(const rcgv::SimBuffer &_buffer) : buffer(_buffer) { }
+
+    uint32_t getNumberOfParts()
+    {
+      return static_cast<uint32_t>(buffer.part.size());
+    }
+
+    bool getComponent(rcgv::Synchronizer::Component &component, uint32_t part)
+    {
+      component=buffer.part[part].component;
+      return true;
+    }
+
+    const std::string &getOut1Mode(uint32_t part)
+    {
+      return buffer.part[part].out1_mode;
+    }
+
+    std::shared_ptr<const rcgv::RawImage> copyImage(rcgv::ImagePool &pool, uint32_t part)
+    {
+      return pool.copy(*buffer.part[part].image);
+    }
+
+  private:
+
+    const rcgv::SimBuffer &buffer;
+};
+
+/*
+  Grabs the given number of buffers from the simulated device and pairs
+  their images with the frame matcher of the receiver. Images of multipart
+  buffers are paired directly.
+*/
+
+Result measure(const Scenario &scenario, int n)
+{
+  Result ret;
+  ret.buffers=0;
+  ret.pairs=0;
+  ret.wrong=0;
+  ret.tsync=0;
+
+  rcgv::SimDevice dev(scenario.config);
+  rcgv::FrameMatcher matcher(scenario.config.multipart, scenario.poolbytes,
+    scenario.maxbytes);
+  rcgv::SimBuffer buffer;
+
+  double tstart=gutil::ProcTime::monotonic();
+
+  for (int i=0; i<n; i++)
+  {
+    dev.grab(buffer);
+    ret.buffers++;
+
+    if (!buffer.incomplete)
+    {
+      double t=gutil::ProcTime::monotonic();
+
+      SimBufferParts parts(buffer);
+      const std::vector<rcgv::FrameMatcher::Pair> &pair=matcher.add(parts, scenario.tol);
+
+      for (size_t k=0; k<pair.size(); k++)
+      {
+        // check that both images belong to the same frame, or to
+        // neighbouring frames in exposure alternate mode
+
+        uint64_t kl=dev.getFrameNumber(pair[k].left->getTimestampNS());
+        uint64_t kd=dev.getFrameNumber(pair[k].disp->getTimestampNS());
+        uint64_t d=(kl > kd ? kl-kd : kd-kl);
+
+        if (d > (scenario.config.alternate ? 1u : 0u))
+        {
+          ret.wrong++;
+        }
+        else
+        {
+          ret.pairs++;
+        }
+      }
+
+      ret.tsync+=gutil::ProcTime::monotonic()-t;
+    }
+  }
+
+  ret.ttotal=gutil::ProcTime::monotonic()-tstart;
+  ret.expected=dev.getCompletePairs();
+  ret.orphaned=matcher.getStatistics().orphaned;
+  ret.expired=matcher.getStatistics().expired;
+
+  return ret;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<Scenario> scenario=getScenarios();
+  std::string name;
+  int n=5000;
+
+  // options that override the parameters of all scenarios
+
+  std::vector<std::string> option;
+
+  int i=1;
+  while (i < argc)
+  {
+    std::string p=argv[i++];
+
+    if (p == "-h")
+    {
+      printHelp(argv[0]);
+      return 0;
+    }
+    else if (p == "-scenario" && i < argc)
+    {
+      name=argv[i++];
+    }
+    else if (p == "-n" && i < argc)
+    {
+      n=std::max(1, std::stoi(argv[i++]));
+    }
+    else if (p == "-multipart" || p == "-alternate" || p == "-nochunk")
+    {
+      option.push_back(p);
+      option.push_back("");
+    }
+    else if ((p == "-size" || p == "-latency" || p == "-jitter" || p == "-tol" ||
+              p == "-reorder" || p == "-incomplete" || p == "-drop" || p == "-maxmem") &&
+             i < argc)
+    {
+      option.push_back(p);
+      option.push_back(argv[i++]);
+    }
+    else
+    {
+      std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+      return 1;
+    }
+  }
+
+  // select scenario and apply options
+
+  if (name.size() > 0)
+  {
+    std::vector<Scenario> list;
+
+    for (size_t k=0; k<scenario.size(); k++)
+    {
+      if (scenario[k].name == name)
+      {
+        list.push_back(scenario[k]);
+      }
+    }
+
+    if (list.size() == 0)
+    {
+      std::cerr << "Unknown scenario: " << name << std::endl;
+      return 1;
+    }
+
+    scenario=list;
+  }
+
+  for (size_t k=0; k<scenario.size(); k++)
+  {
+    rcgv::SimConfig &config=scenario[k].config;
+
+    for (size_t j=0; j<option.size(); j+=2)
+    {
+      const std::string &p=option[j];
+      const std::string &v=option[j+1];
+
+      if (p == "-multipart") config.multipart=true;
+      else if (p == "-alternate") config.alternate=true;
+      else if (p == "-nochunk") config.chunk=false;
+      else if (p == "-latency") config.latency=std::max(0, std::stoi(v));
+      else if (p == "-jitter") config.jitter=std::stod(v)/1000;
+      else if (p == "-tol") scenario[k].tol=static_cast<uint64_t>(std::stod(v)*1000000);
+      else if (p == "-reorder") config.reorder=std::stod(v);
+      else if (p == "-incomplete") config.incomplete=std::stod(v);
+      else if (p == "-drop") config.drop=std::stod(v);
+      else if (p == "-maxmem") scenario[k].maxbytes=static_cast<size_t>(std::stod(v)*1024*1024);
+      else if (p == "-size")
+      {
+        size_t s=v.find('x');
+
+        if (s == std::string::npos)
+        {
+          std::cerr << "Size must be given as <w>x<h>: " << v << std::endl;
+          return 1;
+        }
+
+        config.width=static_cast<size_t>(std::stoi(v.substr(0, s)))&~static_cast<size_t>(3);
+        config.height=static_cast<size_t>(std::stoi(v.substr(s+1)));
+      }
+    }
+  }
+
+  // measure all scenarios
+
+  std::cout << "Buffers per scenario: " << n << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Scenario" << std::right <<
+    std::setw(8) << "pairs" << std::setw(10) << "expected" << std::setw(9) << "match" <<
+    std::setw(7) << "wrong" << std::setw(10) << "orphaned" << std::setw(9) << "expired" <<
+    std::setw(12) << "us/buffer" << std::setw(12) << "buffers/s" << std::endl;
+
+  int ret=0;
+  for (size_t k=0; k<scenario.size(); k++)
+  {
+    Result r=measure(scenario[k], n);
+
+    if (r.wrong > 0 || (scenario[k].expiry && (r.expired == 0 || r.pairs < r.expected)))
+    {
+      ret=1;
+    }
+
+    std::cout << std::left << std::setw(12) << scenario[k].name << std::right <<
+      std::setw(8) << r.pairs << std::setw(10) << r.expected << std::setw(8) <<
+      std::fixed << std::setprecision(1) << 100.0*r.pairs/std::max<uint64_t>(1, r.expected) <<
+      "%" << std::setw(7) << r.wrong << std::setw(10) << r.orphaned << std::setw(9) <<
+      r.expired << std::setw(12) << std::setprecision(3) <<
+      1e6*r.tsync/r.buffers << std::setw(12) << std::setprecision(0) <<
+      r.buffers/r.ttotal << std::endl;
+  }
+
+  return ret;
+}
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_BOUNDEDQUEUE
+#define RC_GENICAM_VIEWER_BOUNDEDQUEUE
+
+#include <gutil/semaphore.h>
+
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Thread safe queue with a maximum size. Pushing blocks while the queue is
+  full and popping blocks while the queue is empty. Elements are stored in a
+  ring buffer that is allocated once.
+*/
+
+template<class T> class BoundedQueue
+{
+  public:
+
+    BoundedQueue(int n) : sem_free(n), sem_used(0), sem(1), list(static_cast<size_t>(n))
+    {
+      first=0;
+      count=0;
+    }
+
+    /**
+      Appends an element at the end of the queue. Blocks while the queue is
+      full.
+    */
+
+    void push(const T &value)
+    {
+      sem_free.decrement();
+
+      {
+        gutil::Lock lock(sem);
+        list[(first+count)%list.size()]=value;
+        count++;
+      }
+
+      sem_used.increment();
+    }
+
+    /**
+      Appends an element at the end of the queue. If the queue is full, then
+      the first element is replaced and the call does not block. This must
+      not be mixed with push() on the same queue.
+
+      @return True if an element has been replaced.
+    */
+
+    bool replace(const T &value)
+    {
+      gutil::Lock lock(sem);
+
+      if (count == list.size())
+      {
+        list[first]=value;
+        first=(first+1)%list.size();
+
+        return true;
+      }
+
+      // sem_free can only lag behind a concurrent pop for a moment
+
+      sem_free.decrement();
+
+      list[(first+count)%list.size()]=value;
+      count++;
+
+      sem_used.increment();
+
+      return false;
+    }
+
+    /**
+      Removes and returns the first element of the queue. Blocks while the
+      queue is empty.
+    */
+
+    T pop()
+    {
+      T ret;
+
+      sem_used.decrement();
+
+      {
+        gutil::Lock lock(sem);
+
+        // the slot is cleared for not holding a reference to the element
+
+        ret=list[first];
+        list[first]=T();
+        first=(first+1)%list.size();
+        count--;
+      }
+
+      sem_free.increment();
+
+      return ret;
+    }
+
+    /**
+      Returns the current number of elements in the queue.
+    */
+
+    int size()
+    {
+      gutil::Lock lock(sem);
+      return static_cast<int>(count);
+    }
+
+  private:
+
+    BoundedQueue(const BoundedQueue &);
+    BoundedQueue &operator=(const BoundedQueue &);
+
+    gutil::Semaphore sem_free;
+    gutil::Semaphore sem_used;
+    gutil::Semaphore sem;
+    std::vector<T> list;
+    size_t first;
+    size_t count;
+};
+
+}
+
+#endif
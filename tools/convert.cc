@@ -0,0 +1,718 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "convert.h"
+
+#include <rc_genicam_api/image.h>
+#include <rc_genicam_api/pixel_formats.h>
+
+#include <atomic>
+#include <algorithm>
+
+// the SIMD code paths are compiled for their specific instruction set and are
+// selected at runtime according to the capabilities of the CPU
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RCGV_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RCGV_TARGET_SSE2
+#define RCGV_TARGET_SSSE3
+#define RCGV_TARGET_AVX2
+#else
+#define RCGV_TARGET_SSE2 __attribute__((target("sse2")))
+#define RCGV_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define RCGV_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace rcgv
+{
+
+namespace
+{
+
+#ifdef RCGV_X86
+
+/*
+  Returns true if the CPU and the operating system support AVX2.
+*/
+
+bool hasAVX2()
+{
+#ifdef _MSC_VER
+  int info[4];
+
+  __cpuid(info, 0);
+
+  if (info[0] < 7)
+  {
+    return false;
+  }
+
+  __cpuid(info, 1);
+
+  // check for OSXSAVE and AVX and if the OS stores the YMM registers
+
+  if ((info[2] & (1<<27)) == 0 || (info[2] & (1<<28)) == 0 ||
+      (_xgetbv(0) & 6) != 6)
+  {
+    return false;
+  }
+
+  __cpuidex(info, 7, 0);
+
+  return (info[1] & (1<<5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+bool hasSSE2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return true;
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[3] & (1<<26)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+
+bool hasSSSE3()
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1<<9)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3") != 0;
+#endif
+}
+
+#endif
+
+SIMDLevel detectSIMDLevel()
+{
+  SIMDLevel ret=SIMD_NONE;
+
+#ifdef RCGV_X86
+  if (hasAVX2())
+  {
+    ret=SIMD_AVX2;
+  }
+  else if (hasSSSE3())
+  {
+    ret=SIMD_SSSE3;
+  }
+  else if (hasSSE2())
+  {
+    ret=SIMD_SSE2;
+  }
+#endif
+
+  return ret;
+}
+
+std::atomic<int> &usedSIMDLevel()
+{
+  static std::atomic<int> level(static_cast<int>(getSupportedSIMDLevel()));
+  return level;
+}
+
+inline int popcount32(uint32_t v)
+{
+  v=v-((v>>1) & 0x55555555);
+  v=(v & 0x33333333)+((v>>2) & 0x33333333);
+  return static_cast<int>((((v+(v>>4)) & 0x0f0f0f0f)*0x01010101)>>24);
+}
+
+/*
+  Scalar reference implementation, which is also used for the remaining
+  pixels of the SIMD implementations.
+*/
+
+int decodeDisparityRowScalar(uint16_t *out, const uint8_t *row, size_t width, bool bigendian,
+                             int inv)
+{
+  int ret=0;
+
+  if (bigendian)
+  {
+    for (size_t i=0; i<width; i++)
+    {
+      int val=(static_cast<int>(row[0])<<8)|row[1];
+      row+=2;
+
+      ret+=(val != inv);
+      *out++=static_cast<uint16_t>(val);
+    }
+  }
+  else
+  {
+    for (size_t i=0; i<width; i++)
+    {
+      int val=(static_cast<int>(row[1])<<8)|row[0];
+      row+=2;
+
+      ret+=(val != inv);
+      *out++=static_cast<uint16_t>(val);
+    }
+  }
+
+  return ret;
+}
+
+#ifdef RCGV_X86
+
+/*
+  Processes 8 disparities per iteration. Byte swapping and counting of
+  invalid values are done in vector registers.
+*/
+
+RCGV_TARGET_SSE2
+int decodeDisparityRowSSE2(uint16_t *out, const uint8_t *row, size_t width, bool bigendian,
+                           int inv)
+{
+  // raw values cannot be equal to an invalid value outside the 16 bit range
+
+  const __m128i vcheck=_mm_set1_epi16((inv >= 0 && inv <= 0xffff) ? -1 : 0);
+  const __m128i vinv=_mm_set1_epi16(static_cast<short>(inv));
+
+  int invalid=0;
+  size_t i=0;
+
+  for (; i+8<=width; i+=8)
+  {
+    __m128i v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(row+2*i));
+
+    if (bigendian)
+    {
+      v=_mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+    __m128i vmask=_mm_and_si128(_mm_cmpeq_epi16(v, vinv), vcheck);
+    invalid+=popcount32(static_cast<uint32_t>(_mm_movemask_epi8(vmask)))>>1;
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out+i), v);
+  }
+
+  int ret=static_cast<int>(i)-invalid;
+
+  return ret+decodeDisparityRowScalar(out+i, row+2*i, width-i, bigendian, inv);
+}
+
+/*
+  Same as the SSE2 version, but with 16 disparities per iteration.
+*/
+
+RCGV_TARGET_AVX2
+int decodeDisparityRowAVX2(uint16_t *out, const uint8_t *row, size_t width, bool bigendian,
+                           int inv)
+{
+  const __m256i vcheck=_mm256_set1_epi16((inv >= 0 && inv <= 0xffff) ? -1 : 0);
+  const __m256i vinv=_mm256_set1_epi16(static_cast<short>(inv));
+
+  int invalid=0;
+  size_t i=0;
+
+  for (; i+16<=width; i+=16)
+  {
+    __m256i v=_mm256_loadu_si256(reinterpret_cast<const __m256i *>(row+2*i));
+
+    if (bigendian)
+    {
+      v=_mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+    }
+
+    __m256i vmask=_mm256_and_si256(_mm256_cmpeq_epi16(v, vinv), vcheck);
+    invalid+=popcount32(static_cast<uint32_t>(_mm256_movemask_epi8(vmask)))>>1;
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out+i), v);
+  }
+
+  int ret=static_cast<int>(i)-invalid;
+
+  return ret+decodeDisparityRowSSE2(out+i, row+2*i, width-i, bigendian, inv);
+}
+
+#endif
+
+/*
+  Scalar reference implementations for color images.
+*/
+
+void convertRGB8RowScalar(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width)
+{
+  for (size_t i=0; i<width; i++)
+  {
+    *r++=*row++;
+    *g++=*row++;
+    *b++=*row++;
+  }
+}
+
+void convertYCbCr411RowScalar(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row,
+                              size_t width)
+{
+  for (size_t i=0; i+4<=width; i+=4)
+  {
+    uint8_t rgb[12];
+    rcg::convYCbCr411toQuadRGB(rgb, row, static_cast<int>(i));
+
+    for (int j=0; j<12; j+=3)
+    {
+      *r++=rgb[j];
+      *g++=rgb[j+1];
+      *b++=rgb[j+2];
+    }
+  }
+
+  // the row does not contain the pixels of an incomplete group at the end
+
+  for (size_t i=width&~static_cast<size_t>(3); i<width; i++)
+  {
+    *r++=0;
+    *g++=0;
+    *b++=0;
+  }
+}
+
+#ifdef RCGV_X86
+
+/*
+  De-interleaves 16 pixels per iteration by shuffling the bytes of three
+  vector registers into the three color planes.
+*/
+
+RCGV_TARGET_SSSE3
+void convertRGB8RowSSSE3(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width)
+{
+  const __m128i r0=_mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i r1=_mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+  const __m128i r2=_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+  const __m128i g0=_mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i g1=_mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+  const __m128i g2=_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+  const __m128i b0=_mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i b1=_mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+  const __m128i b2=_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+
+  size_t i=0;
+  for (; i+16<=width; i+=16)
+  {
+    __m128i v0=_mm_loadu_si128(reinterpret_cast<const __m128i *>(row));
+    __m128i v1=_mm_loadu_si128(reinterpret_cast<const __m128i *>(row+16));
+    __m128i v2=_mm_loadu_si128(reinterpret_cast<const __m128i *>(row+32));
+
+    __m128i vr=_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1)),
+                            _mm_shuffle_epi8(v2, r2));
+    __m128i vg=_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1)),
+                            _mm_shuffle_epi8(v2, g2));
+    __m128i vb=_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1)),
+                            _mm_shuffle_epi8(v2, b2));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(r+i), vr);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(g+i), vg);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(b+i), vb);
+
+    row+=48;
+  }
+
+  convertRGB8RowScalar(r+i, g+i, b+i, row, width-i);
+}
+
+/*
+  Converts 8 pixels, i.e. two groups of 6 bytes, per iteration in 16 bit
+  arithmetic. The constants are the same as in rcg::convYCbCr411toQuadRGB().
+*/
+
+RCGV_TARGET_SSSE3
+void convertYCbCr411RowSSSE3(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row,
+                             size_t width)
+{
+  const __m128i sy=_mm_setr_epi8(0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1);
+  const __m128i scb=_mm_setr_epi8(2, -1, 2, -1, 2, -1, 2, -1, 8, -1, 8, -1, 8, -1, 8, -1);
+  const __m128i scr=_mm_setr_epi8(5, -1, 5, -1, 5, -1, 5, -1, 11, -1, 11, -1, 11, -1, 11, -1);
+  const __m128i c128=_mm_set1_epi16(128);
+  const __m128i c32=_mm_set1_epi16(32);
+  const __m128i crr=_mm_set1_epi16(90);
+  const __m128i cgb=_mm_set1_epi16(-22);
+  const __m128i cgr=_mm_set1_epi16(-46);
+  const __m128i cbb=_mm_set1_epi16(113);
+
+  // each iteration loads 16 bytes, of which only 12 are used
+
+  size_t i=0;
+  for (; i+12<=width; i+=8)
+  {
+    __m128i v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(row));
+
+    __m128i y=_mm_shuffle_epi8(v, sy);
+    __m128i cb=_mm_sub_epi16(_mm_shuffle_epi8(v, scb), c128);
+    __m128i cr=_mm_sub_epi16(_mm_shuffle_epi8(v, scr), c128);
+
+    __m128i rc=_mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(cr, crr), c32), 6);
+    __m128i gc=_mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(cb, cgb),
+                                                          _mm_mullo_epi16(cr, cgr)), c32), 6);
+    __m128i bc=_mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(cb, cbb), c32), 6);
+
+    __m128i vr=_mm_add_epi16(y, rc);
+    __m128i vg=_mm_add_epi16(y, gc);
+    __m128i vb=_mm_add_epi16(y, bc);
+
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(r+i), _mm_packus_epi16(vr, vr));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(g+i), _mm_packus_epi16(vg, vg));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(b+i), _mm_packus_epi16(vb, vb));
+
+    row+=12;
+  }
+
+  convertYCbCr411RowScalar(r+i, g+i, b+i, row, width-i);
+}
+
+/*
+  Same as the SSSE3 version, but with 16 pixels per iteration. Each 128 bit
+  lane holds two groups of 6 bytes.
+*/
+
+RCGV_TARGET_AVX2
+void convertYCbCr411RowAVX2(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row,
+                            size_t width)
+{
+  const __m256i sy=_mm256_setr_epi8(0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1,
+                                    0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1);
+  const __m256i scb=_mm256_setr_epi8(2, -1, 2, -1, 2, -1, 2, -1, 8, -1, 8, -1, 8, -1, 8, -1,
+                                     2, -1, 2, -1, 2, -1, 2, -1, 8, -1, 8, -1, 8, -1, 8, -1);
+  const __m256i scr=_mm256_setr_epi8(5, -1, 5, -1, 5, -1, 5, -1, 11, -1, 11, -1, 11, -1, 11, -1,
+                                     5, -1, 5, -1, 5, -1, 5, -1, 11, -1, 11, -1, 11, -1, 11, -1);
+  const __m256i c128=_mm256_set1_epi16(128);
+  const __m256i c32=_mm256_set1_epi16(32);
+  const __m256i crr=_mm256_set1_epi16(90);
+  const __m256i cgb=_mm256_set1_epi16(-22);
+  const __m256i cgr=_mm256_set1_epi16(-46);
+  const __m256i cbb=_mm256_set1_epi16(113);
+
+  // each iteration loads 16 bytes at offset 0 and 12, of which only 24 bytes
+  // are used
+
+  size_t i=0;
+  for (; i+24<=width; i+=16)
+  {
+    __m256i v=_mm256_inserti128_si256(_mm256_castsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(row))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(row+12)), 1);
+
+    __m256i y=_mm256_shuffle_epi8(v, sy);
+    __m256i cb=_mm256_sub_epi16(_mm256_shuffle_epi8(v, scb), c128);
+    __m256i cr=_mm256_sub_epi16(_mm256_shuffle_epi8(v, scr), c128);
+
+    __m256i rc=_mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(cr, crr), c32), 6);
+    __m256i gc=_mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(cb, cgb),
+                                 _mm256_mullo_epi16(cr, cgr)), c32), 6);
+    __m256i bc=_mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(cb, cbb), c32), 6);
+
+    // packing works per lane, thus the results must be permuted
+
+    __m256i vr=_mm256_add_epi16(y, rc);
+    __m256i vg=_mm256_add_epi16(y, gc);
+    __m256i vb=_mm256_add_epi16(y, bc);
+
+    vr=_mm256_permute4x64_epi64(_mm256_packus_epi16(vr, vr), 0x08);
+    vg=_mm256_permute4x64_epi64(_mm256_packus_epi16(vg, vg), 0x08);
+    vb=_mm256_permute4x64_epi64(_mm256_packus_epi16(vb, vb), 0x08);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(r+i), _mm256_castsi256_si128(vr));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(g+i), _mm256_castsi256_si128(vg));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(b+i), _mm256_castsi256_si128(vb));
+
+    row+=24;
+  }
+
+  convertYCbCr411RowSSSE3(r+i, g+i, b+i, row, width-i);
+}
+
+#endif
+
+}
+
+SIMDLevel getSupportedSIMDLevel()
+{
+  static const SIMDLevel level=detectSIMDLevel();
+  return level;
+}
+
+SIMDLevel getSIMDLevel()
+{
+  return static_cast<SIMDLevel>(usedSIMDLevel().load());
+}
+
+void setSIMDLevel(SIMDLevel level)
+{
+  if (level > getSupportedSIMDLevel())
+  {
+    level=getSupportedSIMDLevel();
+  }
+
+  usedSIMDLevel().store(static_cast<int>(level));
+}
+
+int decodeDisparityRow(uint16_t *out, const uint8_t *row, size_t width, bool bigendian, int inv)
+{
+  switch (getSIMDLevel())
+  {
+#ifdef RCGV_X86
+    case SIMD_AVX2:
+      return decodeDisparityRowAVX2(out, row, width, bigendian, inv);
+
+    case SIMD_SSSE3:
+    case SIMD_SSE2:
+      return decodeDisparityRowSSE2(out, row, width, bigendian, inv);
+#endif
+
+    default:
+      return decodeDisparityRowScalar(out, row, width, bigendian, inv);
+  }
+}
+
+void convertRGB8Row(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width)
+{
+  switch (getSIMDLevel())
+  {
+#ifdef RCGV_X86
+    case SIMD_AVX2:
+    case SIMD_SSSE3:
+      convertRGB8RowSSSE3(r, g, b, row, width);
+      break;
+#endif
+
+    default:
+      convertRGB8RowScalar(r, g, b, row, width);
+      break;
+  }
+}
+
+void convertYCbCr411Row(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width)
+{
+  switch (getSIMDLevel())
+  {
+#ifdef RCGV_X86
+    case SIMD_AVX2:
+      convertYCbCr411RowAVX2(r, g, b, row, width);
+      break;
+
+    case SIMD_SSSE3:
+      convertYCbCr411RowSSSE3(r, g, b, row, width);
+      break;
+#endif
+
+    default:
+      convertYCbCr411RowScalar(r, g, b, row, width);
+      break;
+  }
+}
+
+ColorConverter::ColorConverter()
+{
+  init(0, 0, 0, 0, 0, 0);
+}
+
+void ColorConverter::init(const uint8_t *_pixels, uint64_t _format, size_t _width,
+                          size_t _height, size_t _xpadding, size_t owidth)
+{
+  pixels=_pixels;
+  format=_format;
+  width=_width;
+  height=_height;
+  xpadding=_xpadding;
+
+  bpl=0;
+  if (format == Mono8)
+  {
+    bpl=width;
+  }
+  else if (format == RGB8)
+  {
+    bpl=3*width;
+  }
+  else if (format == YCbCr411_8)
+  {
+    // only complete groups of 4 pixels are stored, the others stay black
+
+    width&=~static_cast<size_t>(3);
+    bpl=(width>>2)*6;
+  }
+
+  if (pixels == 0 || bpl == 0)
+  {
+    width=0;
+    height=0;
+  }
+
+  // downscale factor is chosen such that the raw image covers the disparity
+  // image
+
+  ds=1;
+  if (owidth > 0)
+  {
+    ds=std::max(1, static_cast<int>((width+owidth-1)/owidth));
+  }
+
+  fwidth=0;
+  if (ds == 1)
+  {
+    fwidth=static_cast<long>(std::min(width, owidth));
+  }
+
+  cwidth=0;
+
+  k0=k1=0;
+
+  line.resize(3*owidth);
+  r=g=b=line.data();
+}
+
+void ColorConverter::setRow(long k)
+{
+  k0=std::min(height, static_cast<size_t>(k)*ds);
+  k1=std::min(height, k0+ds);
+
+  cwidth=0;
+  if (k0 < k1)
+  {
+    cwidth=fwidth;
+  }
+
+  if (cwidth > 0)
+  {
+    // convert complete row of raw image
+
+    const uint8_t *row=pixels+k0*(bpl+xpadding);
+    uint8_t *rt=line.data();
+    size_t owidth=line.size()/3;
+
+    if (format == Mono8)
+    {
+      r=g=b=row;
+    }
+    else if (format == RGB8)
+    {
+      r=rt;
+      g=rt+owidth;
+      b=rt+2*owidth;
+      convertRGB8Row(rt, rt+owidth, rt+2*owidth, row, static_cast<size_t>(cwidth));
+    }
+    else if (format == YCbCr411_8)
+    {
+      r=rt;
+      g=rt+owidth;
+      b=rt+2*owidth;
+      convertYCbCr411Row(rt, rt+owidth, rt+2*owidth, row, static_cast<size_t>(cwidth));
+    }
+  }
+}
+
+void ColorConverter::average(uint8_t rgb[3], long i) const
+{
+  size_t i0=std::min(width, static_cast<size_t>(i)*ds);
+  size_t i1=std::min(width, i0+ds);
+
+  if (i0 >= i1 || k0 >= k1)
+  {
+    rgb[0]=rgb[1]=rgb[2]=0;
+    return;
+  }
+
+  int sr=0, sg=0, sb=0;
+  const uint8_t *row=pixels+k0*(bpl+xpadding);
+
+  for (size_t k=k0; k<k1; k++)
+  {
+    if (format == Mono8)
+    {
+      for (size_t j=i0; j<i1; j++)
+      {
+        sr+=row[j];
+      }
+    }
+    else if (format == RGB8)
+    {
+      const uint8_t *p=row+3*i0;
+      for (size_t j=i0; j<i1; j++)
+      {
+        sr+=*p++;
+        sg+=*p++;
+        sb+=*p++;
+      }
+    }
+    else if (format == YCbCr411_8)
+    {
+      for (size_t j=i0; j<i1; j++)
+      {
+        uint8_t c[3];
+        rcg::convYCbCr411toRGB(c, row, static_cast<int>(j));
+        sr+=c[0];
+        sg+=c[1];
+        sb+=c[2];
+      }
+    }
+
+    row+=bpl+xpadding;
+  }
+
+  int n=static_cast<int>((i1-i0)*(k1-k0));
+
+  rgb[0]=static_cast<uint8_t>((sr+n/2)/n);
+
+  if (format == Mono8)
+  {
+    rgb[1]=rgb[2]=rgb[0];
+  }
+  else
+  {
+    rgb[1]=static_cast<uint8_t>((sg+n/2)/n);
+    rgb[2]=static_cast<uint8_t>((sb+n/2)/n);
+  }
+}
+
+}
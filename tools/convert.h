@@ -0,0 +1,204 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_CONVERT
+#define RC_GENICAM_VIEWER_CONVERT
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Instruction set extensions that can be used by the conversion functions.
+*/
+
+enum SIMDLevel { SIMD_NONE, SIMD_SSE2, SIMD_SSSE3, SIMD_AVX2 };
+
+/**
+  Returns the best instruction set extension that is supported by the CPU and
+  the compiler.
+
+  @return Supported SIMD level.
+*/
+
+SIMDLevel getSupportedSIMDLevel();
+
+/**
+  Returns the instruction set extension that is currently used by the
+  conversion functions. By default, this is the supported SIMD level.
+
+  @return Used SIMD level.
+*/
+
+SIMDLevel getSIMDLevel();
+
+/**
+  Limits the instruction set extension that is used by the conversion
+  functions, e.g. for comparing them in benchmarks. The level is capped to the
+  supported level.
+
+  @param level Maximum SIMD level that should be used.
+*/
+
+void setSIMDLevel(SIMDLevel level);
+
+/**
+  Decodes one row of raw 16 bit disparity values into native byte order and
+  counts the number of valid values. Conversion into disparities is left to
+  lookup tables that are indexed by the raw value.
+
+  @param out       Output row with width values.
+  @param row       Raw input row with 2*width bytes.
+  @param width     Number of pixels in the row.
+  @param bigendian True if the input values are stored in big endian.
+  @param inv       Raw value that marks invalid disparities.
+  @return          Number of valid disparities in the row.
+*/
+
+int decodeDisparityRow(uint16_t *out, const uint8_t *row, size_t width, bool bigendian, int inv);
+
+/**
+  De-interleaves one row of RGB8 pixels into three color planes.
+
+  @param r     Output row of red values with width values.
+  @param g     Output row of green values with width values.
+  @param b     Output row of blue values with width values.
+  @param row   Raw input row with 3*width bytes.
+  @param width Number of pixels in the row.
+*/
+
+void convertRGB8Row(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width);
+
+/**
+  Converts one row of YCbCr411_8 pixels into three color planes. The
+  conversion is the same as rcg::convYCbCr411toQuadRGB().
+
+  @param r     Output row of red values with width values.
+  @param g     Output row of green values with width values.
+  @param b     Output row of blue values with width values.
+  @param row   Raw input row with width/4*6 bytes.
+  @param width Number of pixels in the row. If it is not a multiple of 4, then
+               the pixels of the incomplete group at the end are black.
+*/
+
+void convertYCbCr411Row(uint8_t *r, uint8_t *g, uint8_t *b, const uint8_t *row, size_t width);
+
+/**
+  Provides colors of a raw Mono8, RGB8 or YCbCr411_8 image at the resolution
+  of the disparity image, row by row. If the raw image has the same size,
+  complete rows are converted. If it is larger, then blocks of pixels are
+  averaged, but only for the pixels that are requested. Thus, no planar image
+  is created in the resolution of the raw image.
+*/
+
+class ColorConverter
+{
+  public:
+
+    ColorConverter();
+
+    /**
+      Sets the raw image that is used for all following calls.
+
+      @param pixels   Pointer to raw pixels. The image must stay valid.
+      @param format   Pixel format, i.e. Mono8, RGB8 or YCbCr411_8. The colors
+                      of all other formats are black.
+      @param width    Width of raw image.
+      @param height   Height of raw image.
+      @param xpadding Number of padding bytes at the end of each row.
+      @param owidth   Width of the disparity image.
+    */
+
+    void init(const uint8_t *pixels, uint64_t format, size_t width, size_t height,
+              size_t xpadding, size_t owidth);
+
+    /**
+      Returns the downscale factor between raw and disparity image.
+    */
+
+    int getDownscale() const { return ds; }
+
+    /**
+      Must be called before the colors of a row of the disparity image are
+      requested.
+
+      @param k Row in the disparity image.
+    */
+
+    void setRow(long k);
+
+    /**
+      Returns the color of a pixel in the current row.
+
+      @param rgb Output color.
+      @param i   Column in the disparity image.
+    */
+
+    inline void get(uint8_t rgb[3], long i) const
+    {
+      if (ds == 1 && i < cwidth)
+      {
+        rgb[0]=r[i];
+        rgb[1]=g[i];
+        rgb[2]=b[i];
+      }
+      else
+      {
+        average(rgb, i);
+      }
+    }
+
+  private:
+
+    void average(uint8_t rgb[3], long i) const;
+
+    const uint8_t *pixels;
+    uint64_t format;
+    size_t width, height, xpadding, bpl;
+    int ds;
+
+    long fwidth, cwidth;
+    size_t k0, k1;
+
+    std::vector<uint8_t> line;
+    const uint8_t *r, *g, *b;
+};
+
+}
+
+#endif
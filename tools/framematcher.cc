@@ -0,0 +1,119 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "framematcher.h"
+#include "framestats.h"
+
+namespace rcgv
+{
+
+FrameMatcher::FrameMatcher(bool _multipart, size_t poolbytes, size_t syncbytes) :
+  pool(poolbytes), sync(syncbytes)
+{
+  multipart=_multipart;
+  pair.reserve(4);
+}
+
+const std::vector<FrameMatcher::Pair> &FrameMatcher::add(BufferParts &buffer, uint64_t tol)
+{
+  pair.clear();
+
+  uint32_t partn=buffer.getNumberOfParts();
+  bool direct=(multipart && partn > 1);
+  std::shared_ptr<const RawImage> part_left, part_disp;
+
+  for (uint32_t part=0; part<partn; part++)
+  {
+    Synchronizer::Component component;
+
+    if (!buffer.getComponent(component, part))
+    {
+      continue;
+    }
+
+    stat.images++;
+    incCounter(COUNT_IMAGES);
+
+    std::shared_ptr<const RawImage> image=buffer.copyImage(pool, part);
+
+    if (!image)
+    {
+      stat.expired++;
+      incCounter(COUNT_IMAGES_EXPIRED);
+    }
+    else if (direct)
+    {
+      (component == Synchronizer::INTENSITY ? part_left : part_disp)=image;
+    }
+    else
+    {
+      Synchronizer::Window window=Synchronizer::getWindow(buffer.getOut1Mode(part), tol);
+
+      Pair p;
+      if (sync.add(component, image, window, p.left, p.disp))
+      {
+        pair.push_back(p);
+      }
+
+      // count images that are dropped by synchronization
+
+      const Synchronizer::Statistics &st=sync.getStatistics();
+      stat.expired+=st.expired-sync_stat.expired;
+      stat.orphaned+=st.orphaned-sync_stat.orphaned;
+      incCounter(COUNT_IMAGES_EXPIRED, static_cast<long>(st.expired-sync_stat.expired));
+      incCounter(COUNT_IMAGES_ORPHANED, static_cast<long>(st.orphaned-sync_stat.orphaned));
+      sync_stat=st;
+    }
+  }
+
+  if (part_left && part_disp)
+  {
+    Pair p;
+    p.left=part_left;
+    p.disp=part_disp;
+    pair.push_back(p);
+  }
+  else if (part_left || part_disp)
+  {
+    stat.orphaned++;
+    incCounter(COUNT_IMAGES_ORPHANED);
+  }
+
+  stat.pairs+=pair.size();
+
+  return pair;
+}
+
+}
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_FRAMEMATCHER
+#define RC_GENICAM_VIEWER_FRAMEMATCHER
+
+#include "synchronizer.h"
+#include "imagepool.h"
+#include "rawimage.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Access to the parts of a complete buffer that has been grabbed. This
+  decouples the frame matcher from rc_genicam_api, so that buffers of a
+  device and simulated buffers are handled by the same code.
+*/
+
+class BufferParts
+{
+  public:
+
+    virtual ~BufferParts() { }
+
+    virtual uint32_t getNumberOfParts()=0;
+
+    /**
+      Returns the component of a part.
+
+      @param component Returns the component.
+      @param part      Index of part.
+      @return          False if the part does not contain an intensity or
+                       disparity image.
+    */
+
+    virtual bool getComponent(Synchronizer::Component &component, uint32_t part)=0;
+
+    /**
+      Returns the mode of Out1 that is reported in the chunk data of the part,
+      or an empty string if it is not available.
+    */
+
+    virtual const std::string &getOut1Mode(uint32_t part)=0;
+
+    /**
+      Copies the image of a part by means of the given pool, because the
+      buffer is reused after the next grab.
+
+      @return Image, or null if the pool rejects it.
+    */
+
+    virtual std::shared_ptr<const RawImage> copyImage(ImagePool &pool, uint32_t part)=0;
+};
+
+/**
+  Takes the images of all parts of grabbed buffers and returns pairs of
+  intensity and disparity images that belong to the same frame. In
+  SynchronizedComponents mode, both images of a frame are parts of one
+  buffer and are paired directly. Otherwise, e.g. if the GenTL producer does
+  not support multipart, the images are paired by matching their timestamps.
+
+  The frame statistics are updated accordingly. The matcher must only be
+  used by one thread.
+*/
+
+class FrameMatcher
+{
+  public:
+
+    struct Pair
+    {
+      std::shared_ptr<const RawImage> left;
+      std::shared_ptr<const RawImage> disp;
+    };
+
+    /**
+      Counters of images.
+    */
+
+    struct Statistics
+    {
+      Statistics() : images(0), expired(0), orphaned(0), pairs(0) { }
+
+      uint64_t images;   // intensity and disparity images
+      uint64_t expired;  // images dropped for limiting memory
+      uint64_t orphaned; // images that have been removed without partner
+      uint64_t pairs;    // pairs that have been found
+    };
+
+    /**
+      Creates the frame matcher.
+
+      @param multipart True for pairing images of multipart buffers directly.
+      @param poolbytes Maximum number of bytes of all images that are in use.
+      @param syncbytes Maximum number of bytes of images that wait for their
+                       counterpart.
+    */
+
+    FrameMatcher(bool multipart, size_t poolbytes=1024*1024*1024,
+                 size_t syncbytes=256*1024*1024);
+
+    /**
+      Takes all images of a complete buffer.
+
+      @param buffer Parts of the buffer.
+      @param tol    Tolerance for matching timestamps in ns, if the mode of
+                    Out1 is not available.
+      @return       Pairs that have been found, which are valid until the
+                    next call.
+    */
+
+    const std::vector<Pair> &add(BufferParts &buffer, uint64_t tol);
+
+    const Statistics &getStatistics() const { return stat; }
+
+  private:
+
+    FrameMatcher(const FrameMatcher &);
+    FrameMatcher &operator=(const FrameMatcher &);
+
+    bool multipart;
+
+    ImagePool pool;
+    Synchronizer sync;
+    Synchronizer::Statistics sync_stat;
+
+    std::vector<Pair> pair;
+    Statistics stat;
+};
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "framestats.h"
+
+#include <gutil/proctime.h>
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace rcgv
+{
+
+namespace
+{
+
+// histograms have bins of 1 ms up to 2 s, the last bin collects all larger
+// latencies
+
+const int BINS=2001;
+const double BIN_SIZE=0.001;
+
+struct Histogram
+{
+  std::atomic<long> bin[BINS];
+  std::atomic<long> max_us;
+};
+
+std::atomic<long> *getCounters()
+{
+  // counters and histograms are never destroyed, since they can still be
+  // used by background threads or exit handlers
+
+  static std::atomic<long> *counter=new std::atomic<long>[COUNTER_COUNT]();
+  return counter;
+}
+
+Histogram *getHistograms()
+{
+  static Histogram *hist=new Histogram[LATENCY_COUNT]();
+  return hist;
+}
+
+const char *getLatencyName(LatencyID id)
+{
+  static const char *name[]={"pipeline", "grab-to-screen", "sensor-to-screen"};
+  return name[id];
+}
+
+double getDropRate(long dropped, long total)
+{
+  return total > 0 ? 100.0*dropped/total : 0;
+}
+
+}
+
+void incCounter(CounterID id, long n)
+{
+  getCounters()[id].fetch_add(n, std::memory_order_relaxed);
+}
+
+long getCounter(CounterID id)
+{
+  return getCounters()[id].load(std::memory_order_relaxed);
+}
+
+long getUnsynchronizedCount()
+{
+  // images that are still waiting for their partner are counted as well
+
+  return std::max(0L, getCounter(COUNT_IMAGES)-2*getCounter(COUNT_INPUT));
+}
+
+void addLatency(LatencyID id, double t)
+{
+  Histogram &hist=getHistograms()[id];
+
+  int i=std::max(0, std::min(BINS-1, static_cast<int>(t/BIN_SIZE)));
+
+  hist.bin[i].fetch_add(1, std::memory_order_relaxed);
+
+  long us=static_cast<long>(1e6*t);
+  long prev=hist.max_us.load(std::memory_order_relaxed);
+  while (us > prev && !hist.max_us.compare_exchange_weak(prev, us))
+  { }
+}
+
+void addDisplayedFrame(const FrameInfo &info, double displayed)
+{
+  incCounter(COUNT_DISPLAYED);
+
+  if (info.grabbed > 0)
+  {
+    addLatency(LATENCY_GRAB_TO_SCREEN, displayed-info.grabbed);
+  }
+
+  // the device timestamp can only be compared to the wall clock of the host
+  // if both clocks are synchronized, which is assumed if the latency is
+  // plausible
+
+  if (info.timestamp > 0)
+  {
+    double wall=std::chrono::duration<double>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+    wall-=gutil::ProcTime::monotonic()-displayed;
+
+    double t=wall-info.timestamp/1e9;
+
+    if (t >= 0 && t < 10)
+    {
+      addLatency(LATENCY_SENSOR_TO_SCREEN, t);
+    }
+  }
+}
+
+long getLatencyPercentiles(LatencyID id, double &p50, double &p90, double &p99, double &max)
+{
+  Histogram &hist=getHistograms()[id];
+
+  p50=p90=p99=max=0;
+
+  // take a snapshot, since other threads may still add values
+
+  long n=0;
+  long count[BINS];
+  for (int i=0; i<BINS; i++)
+  {
+    count[i]=hist.bin[i].load(std::memory_order_relaxed);
+    n+=count[i];
+  }
+
+  if (n > 0)
+  {
+    max=hist.max_us.load(std::memory_order_relaxed)/1e6;
+
+    const double p[]={0.5, 0.9, 0.99};
+    double *v[]={&p50, &p90, &p99};
+
+    for (int j=0; j<3; j++)
+    {
+      // upper end of the bin that contains the percentile, but not more
+      // than the maximum
+
+      long target=static_cast<long>(p[j]*n+0.5);
+      long sum=0;
+      int i=0;
+
+      while (i < BINS-1 && sum+count[i] < target)
+      {
+        sum+=count[i];
+        i++;
+      }
+
+      *v[j]=std::min((i+1)*BIN_SIZE, max);
+    }
+  }
+
+  return n;
+}
+
+std::string getLatencyLine()
+{
+  std::ostringstream out;
+
+  out << std::fixed << std::setprecision(0) << "Latency p50/p99 [ms]:";
+
+  for (int i=LATENCY_GRAB_TO_SCREEN; i<LATENCY_COUNT; i++)
+  {
+    double p50, p90, p99, max;
+
+    if (getLatencyPercentiles(static_cast<LatencyID>(i), p50, p90, p99, max) > 0)
+    {
+      out << " " << getLatencyName(static_cast<LatencyID>(i)) << " " << 1000*p50 << "/" <<
+        1000*p99;
+    }
+  }
+
+  out << std::setprecision(1) << ", dropped: sync " <<
+    getDropRate(getUnsynchronizedCount(), getCounter(COUNT_IMAGES)) << "%, input " <<
+    getDropRate(getCounter(COUNT_INPUT_DROPPED), getCounter(COUNT_INPUT)) << "%, models " <<
+    getDropRate(getCounter(COUNT_MODELS_DROPPED), getCounter(COUNT_MODELS)) << "%";
+
+  return out.str();
+}
+
+std::string getLatencySummary()
+{
+  std::ostringstream out;
+
+  out << "Frames: " << getCounter(COUNT_IMAGES) << " images received, " <<
+    getCounter(COUNT_INPUT) << " synchronized pairs, " << getCounter(COUNT_MODELS) <<
+    " models, " << getCounter(COUNT_DISPLAYED) << " displayed" << std::endl;
+
+  out << std::fixed << std::setprecision(1);
+  out << "Dropped: " << getUnsynchronizedCount() << " unsynchronized images (" <<
+    getDropRate(getUnsynchronizedCount(), getCounter(COUNT_IMAGES)) << "%, " <<
+    getCounter(COUNT_IMAGES_ORPHANED) << " orphaned, " << getCounter(COUNT_IMAGES_EXPIRED) <<
+    " expired), " << getCounter(COUNT_INPUT_DROPPED) << " inputs (" <<
+    getDropRate(getCounter(COUNT_INPUT_DROPPED), getCounter(COUNT_INPUT)) << "%), " <<
+    getCounter(COUNT_MODELS_DROPPED) << " models (" <<
+    getDropRate(getCounter(COUNT_MODELS_DROPPED), getCounter(COUNT_MODELS)) << "%)" <<
+    std::endl;
+
+  for (int i=0; i<LATENCY_COUNT; i++)
+  {
+    double p50, p90, p99, max;
+    long n=getLatencyPercentiles(static_cast<LatencyID>(i), p50, p90, p99, max);
+
+    out << "Latency " << getLatencyName(static_cast<LatencyID>(i)) << " [ms]: ";
+
+    if (n == 0)
+    {
+      out << "no data" << std::endl;
+      continue;
+    }
+
+    out << "p50 " << 1000*p50 << ", p90 " << 1000*p90 << ", p99 " << 1000*p99 << ", max " <<
+      1000*max << std::endl;
+
+    // histogram with 10 ms resolution
+
+    Histogram &hist=getHistograms()[i];
+
+    for (int k=0; k < BINS; k+=10)
+    {
+      long c=0;
+      for (int j=k; j<k+10 && j<BINS; j++)
+      {
+        c+=hist.bin[j].load(std::memory_order_relaxed);
+      }
+
+      if (c > 0)
+      {
+        out << "  " << std::setw(5) << k << " - " << std::setw(5) << std::min(k+10, BINS-1) <<
+          (k+10 >= BINS ? "+" : " ") << std::setw(8) << c << " " <<
+          std::string(static_cast<size_t>(std::max(1L, 50*c/n)), '#') << std::endl;
+      }
+    }
+  }
+
+  return out.str();
+}
+
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_FRAMESTATS
+#define RC_GENICAM_VIEWER_FRAMESTATS
+
+#include <cstdint>
+#include <string>
+
+namespace rcgv
+{
+
+/**
+  Times of a frame on its way from the sensor to the screen.
+*/
+
+struct FrameInfo
+{
+  FrameInfo() : timestamp(0), grabbed(0), started(0), finished(0) { }
+
+  uint64_t timestamp;   // device timestamp of the disparity image in ns
+  double grabbed;       // monotonic host time when the images were grabbed
+  double started;       // monotonic host time when the modeler started
+  double finished;      // monotonic host time when the model was published
+};
+
+/**
+  Counters of frames and of frames that are dropped at the queues.
+*/
+
+enum CounterID
+{
+  COUNT_IMAGES,          // left and disparity images received from the device
+  COUNT_IMAGES_EXPIRED,  // images dropped for limiting memory
+  COUNT_IMAGES_ORPHANED, // images without partner, removed after a newer pair
+  COUNT_INPUT,           // synchronized image pairs given to the modeler
+  COUNT_INPUT_DROPPED,   // image pairs replaced before the modeler took them
+  COUNT_MODELS,          // models published by the modeler
+  COUNT_MODELS_DROPPED,  // models replaced before the viewer polled them
+  COUNT_DISPLAYED,       // models drawn on the screen
+  COUNTER_COUNT
+};
+
+/**
+  Latencies that are collected in histograms.
+*/
+
+enum LatencyID
+{
+  LATENCY_PIPELINE,          // grabbed to published model
+  LATENCY_GRAB_TO_SCREEN,    // grabbed to drawn on the screen
+  LATENCY_SENSOR_TO_SCREEN,  // device timestamp to drawn on the screen
+  LATENCY_COUNT
+};
+
+/**
+  Increments a counter. This can be called from any thread.
+*/
+
+void incCounter(CounterID id, long n=1);
+
+long getCounter(CounterID id);
+
+/**
+  Returns the number of received images that have not been handed over to
+  the modeler, because no synchronized partner has been found.
+*/
+
+long getUnsynchronizedCount();
+
+/**
+  Adds a latency in seconds to its histogram. This can be called from any
+  thread and does not allocate memory.
+*/
+
+void addLatency(LatencyID id, double t);
+
+/**
+  Adds all latencies of a frame that has been drawn on the screen at the
+  given monotonic host time and counts the frame as displayed. The latency
+  from the sensor is only taken into account if the device clock appears to
+  be synchronized to the host clock, e.g. by PTP.
+*/
+
+void addDisplayedFrame(const FrameInfo &info, double displayed);
+
+/**
+  Computes percentiles from the histogram of a latency.
+
+  @return Number of values in the histogram.
+*/
+
+long getLatencyPercentiles(LatencyID id, double &p50, double &p90, double &p99, double &max);
+
+/**
+  Returns latency percentiles and drop rates as one line of text.
+*/
+
+std::string getLatencyLine();
+
+/**
+  Returns counters, drop rates and histograms of all latencies as text with
+  several lines.
+*/
+
+std::string getLatencySummary();
+
+}
+
+#endif
@@ -34,8 +34,18 @@
  */
 
 #include "receiver.h"
+#include "replay.h"
 #include "modeler.h"
 #include "gcworld.h"
+#include "recorder.h"
+#include "shmpublisher.h"
+#include "timing.h"
+#include "framestats.h"
+#include "alloccount.h"
+
+#ifndef WIN32
+#include "streamserver.h"
+#endif
 
 #include <Base/GCException.h>
 
@@ -46,6 +56,14 @@
 #include <gutil/misc.h>
 #include <gutil/exception.h>
 
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <csignal>
+#include <thread>
+#include <chrono>
+
 #ifdef WIN32
 #undef min
 #undef max
@@ -69,12 +87,50 @@ void printHelp(const char *prgname)
   std::cout << std::endl;
   std::cout << "- Press 'h' for an overview of general key codes." << std::endl;
   std::cout << "- Use cursor keys to switch between some GenICam parameters and their values." << std::endl;
+  std::cout << "- Press 'i' repeatedly for showing framerate, timings and latencies." << std::endl;
+  std::cout << "- Press 'R' for starting and stopping recording of all synchronized images." << std::endl;
   std::cout << std::endl;
   std::cout << "Command line options are:" << std::endl;
   std::cout << "-h              Shows this help and exits." << std::endl;
   std::cout << "-bg <r>,<g>,<b> Setting background color." << std::endl;
   std::cout << "-key <codes>    Sends the given keycodes to the viewer on startup." << std::endl;
   std::cout << "-timeout <t>    Timeout in seconds until giving up. 0 for inifinity." << std::endl;
+  std::cout << "-threads <n>    Number of threads for creating the mesh. 0 for number of cores." << std::endl;
+  std::cout << "-timings <file> Writes percentiles of all timers and latencies into the file on" << std::endl;
+  std::cout << "                exit. A summary of latencies and dropped frames is always" << std::endl;
+  std::cout << "                printed on exit." << std::endl;
+  std::cout << "-record <file>  Records all synchronized images into the given file from the" << std::endl;
+  std::cout << "                start. Recordings that are started with 'R' are stored as" << std::endl;
+  std::cout << "                recording_<nnnn>.rcgv in the home directory." << std::endl;
+  std::cout << "-replay <file>  Replays a recording instead of connecting to a device." << std::endl;
+  std::cout << "-rate <hz>      Replays with a fixed rate instead of the recorded timing. 'max'" << std::endl;
+  std::cout << "                for replaying as fast as possible. In this case, frames that" << std::endl;
+  std::cout << "                cannot be processed in time are dropped as with a device." << std::endl;
+  std::cout << "-repeat <n>     Number of times that the recording is replayed. 0 for endless." << std::endl;
+  std::cout << "                The viewer exits after the last frame. Default is 1." << std::endl;
+  std::cout << "-multipart      Requests intensity and disparity images of the same frame in" << std::endl;
+  std::cout << "                one buffer, which avoids matching timestamps. Timestamps are" << std::endl;
+  std::cout << "                matched if the device or GenTL producer does not support it." << std::endl;
+  std::cout << "-headless       Runs without window, e.g. on a server. Models are created as" << std::endl;
+  std::cout << "                usual and handed over to all given outputs, e.g. -record." << std::endl;
+  std::cout << "                The device must be given. The program stops on SIGINT or" << std::endl;
+  std::cout << "                SIGTERM." << std::endl;
+  std::cout << "-stats <s>      Prints framerate, load and latencies every <s> seconds in" << std::endl;
+  std::cout << "                headless mode. 0 for off. Default is 2." << std::endl;
+  std::cout << "-duration <s>   Stops after the given number of seconds in headless mode. 0" << std::endl;
+  std::cout << "                for running until the device stops or a signal is received." << std::endl;
+  std::cout << "-shm <name>     Publishes the latest meshes in shared memory with the given" << std::endl;
+  std::cout << "                name, e.g. " << rcgv::SHM_DEFAULT_NAME << ", for other processes on the same host." << std::endl;
+#ifndef WIN32
+  std::cout << "-stream <addr>  Streams point clouds with quantized coordinates to all clients" << std::endl;
+  std::cout << "                that connect to the given address, which can be <port> on" << std::endl;
+  std::cout << "                the loopback interface, <host>:<port>, :<port> on all" << std::endl;
+  std::cout << "                interfaces or a path for a Unix domain socket. Slow clients" << std::endl;
+  std::cout << "                miss frames." << std::endl;
+  std::cout << "-streamenc <e>  Encoding of colors for streaming, which is none, gray8 or" << std::endl;
+  std::cout << "                rgb565, optionally with +delta for delta coding of points." << std::endl;
+  std::cout << "                Default is rgb565+delta." << std::endl;
+#endif
   std::cout << std::endl;
   std::cout << "<device-id> Device from which images will taken. It can be ommitted if there" << std::endl;
   std::cout << "is only one device available." << std::endl;
@@ -84,26 +140,126 @@ void printHelp(const char *prgname)
 }
 
 std::shared_ptr<rcgv::Modeler> modeler;
-std::shared_ptr<rcgv::Receiver> receiver;
+std::shared_ptr<rcgv::Source> source;
 std::shared_ptr<rcgv::GCWorld> world;
+std::vector<std::shared_ptr<rcgv::Sink> > sinks;
 int id=0;
+std::string timings_file;
+
+/*
+  Returns the delay in ms until the next model should be polled. The models
+  of the modeler cannot wake up the GLUT thread directly. Instead, polling
+  is scheduled shortly after the time at which the next model is expected
+  according to the rate of the device. While an expected model is overdue,
+  polling is done with a short interval. If the device does not deliver
+  anymore, polling falls back to a slow idle rate.
+
+  @param finished Time when the last model has been published or 0 if no
+                  model has been polled.
+*/
+
+unsigned int getPollDelay(double finished)
+{
+  const double IDLE=0.1;      // delay while device is idle
+  const double OVERDUE=0.002; // delay while model is overdue
+
+  static double last=0;       // time when the last model was published
+  static double period=0;     // estimated time between models
+
+  if (finished > 0)
+  {
+    if (last > 0 && finished > last)
+    {
+      double d=std::min(IDLE, finished-last);
+      period=(period > 0 ? 0.8*period+0.2*d : d);
+    }
+
+    last=finished;
+  }
+
+  double delay=IDLE;
+
+  if (last > 0 && period > 0)
+  {
+    double now=gutil::ProcTime::monotonic();
+    double next=last+period;
+
+    if (now < next)
+    {
+      delay=next-now+0.001;
+    }
+    else if (now < last+3*period)
+    {
+      delay=OVERDUE;
+    }
+  }
+
+  return static_cast<unsigned int>(std::max(1.0, std::min(1000*IDLE, 1000*delay+0.5)));
+}
+
+/*
+  Returns the occupancy of the pipeline stages of the modeler and the number
+  of heap allocations per frame since the last call.
+
+  @param n      Number of frames since the last call.
+  @param nalloc Number of allocations at the last call, which is updated.
+*/
+
+std::string getLoad(int n, uint64_t &nalloc)
+{
+  std::vector<std::string> name;
+  std::vector<double> occupancy;
+  modeler->getStageOccupancy(name, occupancy);
+
+  std::ostringstream load;
+  for (size_t i=0; i<name.size(); i++)
+  {
+    if (i > 0) load << ", ";
+    load << name[i] << " " << static_cast<int>(100*occupancy[i]+0.5) << "%";
+  }
+
+  // number of heap allocations of the modeler per frame, which should be 0
+  // after warm-up
+
+  if (rcgv::isAllocationCounting())
+  {
+    uint64_t a=modeler->getAllocationCount();
+    load << ", alloc/frame " << static_cast<double>(a-nalloc)/std::max(1, n);
+    nalloc=a;
+  }
+
+  return load.str();
+}
 
 void getNextModel(int)
 {
   static double tprev=0;
   static int n=0;
+  static uint64_t nalloc=0;
 
-  std::shared_ptr<gvr::Model> model=modeler->nextModel();
+  rcgv::FrameInfo info;
+  std::shared_ptr<gvr::Model> model=modeler->nextModel(&info);
 
   if (model)
   {
     // set model and remove old one
 
-    int nextid=(id+1)%2;
-    model->setID(1000+nextid);
-    world->addModel(model);
-    world->removeAllModels(1000+id);
-    id=nextid;
+    {
+      rcgv::ScopedTiming timing(rcgv::TIMING_MODEL_SWAP);
+
+      int nextid=(id+1)%2;
+      model->setID(1000+nextid);
+      world->addModel(model, info);
+      world->removeAllModels(1000+id);
+      id=nextid;
+    }
+
+    // hand model over to all other outputs
+
+    for (size_t i=0; i<sinks.size(); i++)
+    {
+      sinks[i]->add(model, info);
+    }
 
     // measure framerate
 
@@ -114,11 +270,12 @@ void getNextModel(int)
     {
       tprev=tcurr;
       n=0;
+      nalloc=modeler->getAllocationCount();
     }
 
     if (tcurr-tprev > 2)
     {
-      world->setFramerate(n/(tcurr-tprev));
+      world->setFramerate(n/(tcurr-tprev), getLoad(n, nalloc));
       tprev=tcurr;
       n=0;
     }
@@ -128,18 +285,142 @@ void getNextModel(int)
     gvr::GLRedisplay();
   }
 
-  if (!receiver->isRunning())
+  // report results of captures
+
+  world->update();
+
+  if (!source->isRunning())
   {
     gvr::GLLeaveMainLoop();
     return;
   }
 
-  gvr::GLTimerFunc(40, getNextModel, 0);
+  gvr::GLTimerFunc(getPollDelay(model ? info.finished : 0), getNextModel, 0);
+}
+
+volatile std::sig_atomic_t stop_signal=0;
+
+void onSignal(int)
+{
+  stop_signal=1;
+}
+
+/*
+  Polls models without any window until the source stops, a signal is
+  received or the given duration is over.
+
+  @param record_file Name of file for recording all synchronized images or
+                     empty.
+  @param duration    Maximum run time in seconds or 0 for infinity.
+  @param interval    Interval in seconds for printing statistics or 0.
+*/
+
+void runHeadless(const std::string &record_file, double duration, double interval)
+{
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  std::shared_ptr<rcgv::Recorder> recorder;
+
+  if (record_file.size() > 0)
+  {
+    recorder=std::make_shared<rcgv::Recorder>(record_file);
+    source->setRecorder(recorder);
+
+    std::cout << "Recording to " << record_file << std::endl;
+  }
+
+  double tstart=gutil::ProcTime::monotonic();
+  double tprev=tstart;
+  int n=0;
+  uint64_t nalloc=modeler->getAllocationCount();
+
+  while (!stop_signal && source->isRunning() &&
+    (duration <= 0 || gutil::ProcTime::monotonic() < tstart+duration))
+  {
+    rcgv::FrameInfo info;
+    std::shared_ptr<gvr::Model> model=modeler->nextModel(&info);
+
+    double finished=0;
+
+    if (model)
+    {
+      finished=info.finished;
+      n++;
+
+      for (size_t i=0; i<sinks.size(); i++)
+      {
+        sinks[i]->add(model, info);
+      }
+    }
+
+    double tcurr=gutil::ProcTime::monotonic();
+
+    if (interval > 0 && tcurr-tprev > interval)
+    {
+      std::cout << std::fixed << std::setprecision(1) << n/(tcurr-tprev) << " fps, " <<
+        getLoad(n, nalloc) << std::endl;
+      std::cout << rcgv::getLatencyLine() << std::endl;
+
+      if (recorder)
+      {
+        std::cout << recorder->getStatusLine() << std::endl;
+      }
+
+      tprev=tcurr;
+      n=0;
+    }
+
+    // the model is released before waiting, so that the modeler can reuse it
+
+    model.reset();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(getPollDelay(finished)));
+  }
+
+  // wait until the recording has been written completely
+
+  if (recorder)
+  {
+    source->setRecorder(std::shared_ptr<rcgv::Recorder>());
+    recorder->stop();
+
+    while (!recorder->isFinished())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::cout << "Stored " << recorder->getName() << ": " << recorder->getStatusLine() <<
+      std::endl;
+  }
 }
 
 void closeDevice()
 {
-  receiver->close();
+  // the source has already been closed and freed if main returns
+
+  if (source)
+  {
+    source->close();
+  }
+}
+
+void storeTimings()
+{
+  if (rcgv::writeTimings(timings_file))
+  {
+    std::ofstream out(timings_file.c_str(), std::ios::app);
+    out << std::endl << rcgv::getLatencySummary();
+  }
+  else
+  {
+    std::cerr << "Cannot store timings: " << timings_file << std::endl;
+  }
+}
+
+void printLatencySummary()
+{
+  std::cout << rcgv::getLatencySummary();
 }
 
 }
@@ -148,12 +429,39 @@ int main(int argc, char *argv[])
 {
   try
   {
-    gvr::GLInit(argc, argv);
+    // GLUT is not initialized in headless mode, since there may be no display
+
+    bool headless=false;
+    for (int k=1; k<argc; k++)
+    {
+      if (std::string(argv[k]) == "-headless")
+      {
+        headless=true;
+      }
+    }
+
+    if (!headless)
+    {
+      gvr::GLInit(argc, argv);
+    }
 
     int i=1;
     std::string bg="44,51,58";
     std::string keycodes;
     double timeout=3;
+    int threads=0;
+    std::string record_file;
+    std::string replay_file;
+    double rate=0;
+    int repeat=1;
+    bool multipart=false;
+    double stats=2;
+    double duration=0;
+    std::string shm_name;
+#ifndef WIN32
+    std::string stream_address;
+    int stream_flags=rcgv::STREAM_RGB565 | rcgv::STREAM_DELTA;
+#endif
 
     while (i < argc && argv[i][0] == '-')
     {
@@ -177,6 +485,79 @@ int main(int argc, char *argv[])
         i++;
         timeout=std::stod(argv[i++]);
       }
+      else if (i+1 < argc && std::string(argv[i]) == "-threads")
+      {
+        i++;
+        threads=std::stoi(argv[i++]);
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-timings")
+      {
+        i++;
+        timings_file=argv[i++];
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-record")
+      {
+        i++;
+        record_file=argv[i++];
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-replay")
+      {
+        i++;
+        replay_file=argv[i++];
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-rate")
+      {
+        i++;
+        std::string v=argv[i++];
+        rate=(v == "max" ? -1 : std::max(0.0, std::stod(v)));
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-repeat")
+      {
+        i++;
+        repeat=std::max(0, std::stoi(argv[i++]));
+      }
+      else if (std::string(argv[i]) == "-multipart")
+      {
+        i++;
+        multipart=true;
+      }
+      else if (std::string(argv[i]) == "-headless")
+      {
+        i++;
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-stats")
+      {
+        i++;
+        stats=std::max(0.0, std::stod(argv[i++]));
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-duration")
+      {
+        i++;
+        duration=std::max(0.0, std::stod(argv[i++]));
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-shm")
+      {
+        i++;
+        shm_name=argv[i++];
+      }
+#ifndef WIN32
+      else if (i+1 < argc && std::string(argv[i]) == "-stream")
+      {
+        i++;
+        stream_address=argv[i++];
+      }
+      else if (i+1 < argc && std::string(argv[i]) == "-streamenc")
+      {
+        i++;
+        stream_flags=rcgv::getStreamFlags(argv[i++]);
+
+        if (stream_flags < 0)
+        {
+          std::cerr << "Unknown stream encoding: " << argv[i-1] << std::endl;
+          return 1;
+        }
+      }
+#endif
       else
       {
         std::cerr << "Unknown parameter or missing value: " << argv[i] << std::endl;
@@ -196,56 +577,117 @@ int main(int argc, char *argv[])
       }
     }
 
-    // create modeler and receiver
+    // a device cannot be chosen interactively without window
+
+    if (headless && name == 0 && replay_file.size() == 0)
+    {
+      std::cerr << "A device must be given in headless mode" << std::endl;
+      return 1;
+    }
+
+    // create modeler and receiver or replay
+
+    modeler=std::make_shared<rcgv::Modeler>(threads);
+
+    if (replay_file.size() > 0)
+    {
+      source=std::make_shared<rcgv::Replay>(modeler, replay_file, rate, repeat);
+    }
+    else
+    {
+      source=std::make_shared<rcgv::Receiver>(modeler, name, timeout, genicam_param,
+        multipart);
+    }
 
-    modeler=std::make_shared<rcgv::Modeler>();
-    receiver=std::make_shared<rcgv::Receiver>(modeler, name, timeout, genicam_param);
     atexit(closeDevice);
+    atexit(printLatencySummary);
 
-    // create window
+    if (timings_file.size() > 0)
+    {
+      atexit(storeTimings);
+    }
 
-    gvr::GLInitWindow(-1, -1, 800, 600, "gc_3dviewer");
-    world=std::make_shared<rcgv::GCWorld>(800, 600, receiver);
-    world->setCapturePrefix("capture");
+    // create additional outputs
 
-    // set background color
+    if (shm_name.size() > 0)
+    {
+      sinks.push_back(std::make_shared<rcgv::ShmPublisher>(shm_name));
+    }
+
+#ifndef WIN32
+    if (stream_address.size() > 0)
+    {
+      std::shared_ptr<rcgv::StreamServer> server=
+        std::make_shared<rcgv::StreamServer>(stream_address, stream_flags);
+
+      std::cout << "Streaming point clouds on " << server->getAddress() << std::endl;
+
+      sinks.push_back(server);
+    }
+#endif
 
-    if (bg.size() > 0)
+    if (headless)
+    {
+      runHeadless(record_file, duration, stats);
+    }
+    else
     {
-      std::vector<std::string> list;
+      // create window
+
+      gvr::GLInitWindow(-1, -1, 800, 600, "gc_3dviewer");
+      world=std::make_shared<rcgv::GCWorld>(800, 600, source);
+      world->setCapturePrefix("capture");
 
-      gutil::split(list, bg, ',');
+      // set background color
 
-      if (list.size() != 3)
+      if (bg.size() > 0)
       {
-        throw gutil::InvalidArgumentException(std::string("Illegal format: ")+bg);
+        std::vector<std::string> list;
+
+        gutil::split(list, bg, ',');
+
+        if (list.size() != 3)
+        {
+          throw gutil::InvalidArgumentException(std::string("Illegal format: ")+bg);
+        }
+
+        float r=std::max(0.0f, std::min(1.0f, std::stoi(list[0])/255.0f));
+        float g=std::max(0.0f, std::min(1.0f, std::stoi(list[1])/255.0f));
+        float b=std::max(0.0f, std::min(1.0f, std::stoi(list[2])/255.0f));
+
+        world->setBackgroundColor(r, g, b);
       }
 
-      float r=std::max(0.0f, std::min(1.0f, std::stoi(list[0])/255.0f));
-      float g=std::max(0.0f, std::min(1.0f, std::stoi(list[1])/255.0f));
-      float b=std::max(0.0f, std::min(1.0f, std::stoi(list[2])/255.0f));
+      // start recording
 
-      world->setBackgroundColor(r, g, b);
-    }
+      if (record_file.size() > 0)
+      {
+        world->startRecording(record_file);
+      }
 
-    // apply keycodes
+      // apply keycodes
 
-    for (size_t k=0; k<keycodes.size(); k++)
-    {
-      world->onKey(keycodes[k], 0, 0);
-    }
+      for (size_t k=0; k<keycodes.size(); k++)
+      {
+        world->onKey(keycodes[k], 0, 0);
+      }
+
+      // register additional timer callback
 
-    // register additional timer callback
+      gvr::GLTimerFunc(getPollDelay(0), getNextModel, 0);
 
-    gvr::GLTimerFunc(40, getNextModel, 0);
+      // enter main loop
 
-    // enter main loop
+      GLMainLoop(*world.get());
+    }
 
-    GLMainLoop(*world.get());
+    // stop receiver or replay before freeing outputs, receiver or replay and
+    // modeler
 
-    // free receiver and modeler
+    source->close();
 
-    receiver.reset();
+    sinks.clear();
+    source.reset();
     modeler.reset();
   }
   catch (const std::exception &ex)
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shmreader.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <algorithm>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Reads the meshes that gc_3dviewer publishes in shared memory with the option" << std::endl;
+  std::cout << "-shm and prints the rate, size and latency of frames. This is an example for" << std::endl;
+  std::cout << "using the reader library." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h              Shows this help and exits." << std::endl;
+  std::cout << "-name <name>    Name of shared memory. Default is " << rcgv::SHM_DEFAULT_NAME << "." << std::endl;
+  std::cout << "-n <n>          Number of frames until exit. 0 for infinity, which is the" << std::endl;
+  std::cout << "                default." << std::endl;
+}
+
+double monotonic()
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::string name=rcgv::SHM_DEFAULT_NAME;
+  long n=0;
+
+  int i=1;
+  while (i < argc)
+  {
+    std::string p=argv[i++];
+
+    if (p == "-h")
+    {
+      printHelp(argv[0]);
+      return 0;
+    }
+    else if (p == "-name" && i < argc)
+    {
+      name=argv[i++];
+    }
+    else if (p == "-n" && i < argc)
+    {
+      n=std::max(0L, std::stol(argv[i++]));
+    }
+    else
+    {
+      std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+      return 1;
+    }
+  }
+
+  rcgv::ShmReader reader(name);
+  rcgv::ShmFrameView view;
+
+  long count=0, overwritten=0, frames=0;
+  double vertices=0, latency=0;
+  float zmax=0;
+  double tprev=monotonic();
+
+  while (n == 0 || count < n)
+  {
+    if (reader.getLatest(view, view.number))
+    {
+      // touch all data as a consumer would do, without copying it
+
+      for (uint32_t k=0; k<view.vertex_count; k++)
+      {
+        zmax=std::max(zmax, view.vertex[3*k+2]);
+      }
+
+      if (reader.isValid(view))
+      {
+        count++;
+        frames++;
+        vertices+=view.vertex_count;
+
+        // the monotonic clock of the publisher is the steady clock on Linux
+
+        latency+=monotonic()-view.grabbed;
+      }
+      else
+      {
+        overwritten++;
+      }
+    }
+    else
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double t=monotonic();
+
+    if (t-tprev >= 1)
+    {
+      if (!reader.isOpen())
+      {
+        std::cout << "Waiting for publisher " << name << std::endl;
+      }
+      else if (frames > 0)
+      {
+        std::cout << std::fixed << std::setprecision(1) << frames/(t-tprev) << " fps, " <<
+          static_cast<long>(vertices/frames) << " vertices, max depth " << zmax <<
+          " m, grab to read " <<
+          1000*latency/frames << " ms, overwritten " << overwritten << std::endl;
+      }
+
+      frames=0;
+      vertices=0;
+      zmax=0;
+      latency=0;
+      tprev=t;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamclient.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+
+/*
+  Print help text on standard output.
+*/
+
+void printHelp(const char *prgname)
+{
+  std::cout << prgname << " <options> <address>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Receives the point clouds that gc_3dviewer streams with the option -stream and" << std::endl;
+  std::cout << "prints the rate and size of frames. The address is given as <port>," << std::endl;
+  std::cout << "<host>:<port> or as path of a Unix domain socket. This is an example for using" << std::endl;
+  std::cout << "the client library." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Command line options are:" << std::endl;
+  std::cout << "-h              Shows this help and exits." << std::endl;
+  std::cout << "-n <n>          Number of frames until exit. 0 for infinity, which is the" << std::endl;
+  std::cout << "                default." << std::endl;
+}
+
+double monotonic()
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::string address;
+  long n=0;
+
+  int i=1;
+  while (i < argc)
+  {
+    std::string p=argv[i++];
+
+    if (p == "-h")
+    {
+      printHelp(argv[0]);
+      return 0;
+    }
+    else if (p == "-n" && i < argc)
+    {
+      n=std::max(0L, std::stol(argv[i++]));
+    }
+    else if (p.size() > 0 && p[0] != '-' && address.size() == 0)
+    {
+      address=p;
+    }
+    else
+    {
+      std::cerr << "Unknown parameter or missing value: " << p << std::endl;
+      return 1;
+    }
+  }
+
+  if (address.size() == 0)
+  {
+    printHelp(argv[0]);
+    return 1;
+  }
+
+  rcgv::StreamClient client;
+
+  if (!client.connect(address))
+  {
+    std::cerr << "Cannot connect to " << address << std::endl;
+    return 1;
+  }
+
+  std::vector<uint8_t> data;
+  rcgv::StreamFrame frame;
+
+  long count=0, frames=0;
+  double bytes=0, points=0;
+  uint64_t last=0, missed=0;
+  double tprev=monotonic();
+
+  while ((n == 0 || count < n) && client.receive(data))
+  {
+    if (!rcgv::decodeFrame(frame, data.data(), data.size()))
+    {
+      std::cerr << "Received invalid frame" << std::endl;
+      return 1;
+    }
+
+    // frames that are dropped by the server for slow clients are counted by
+    // gaps of the frame number
+
+    if (last > 0 && frame.number > last+1)
+    {
+      missed+=frame.number-last-1;
+    }
+
+    last=frame.number;
+
+    count++;
+    frames++;
+    bytes+=data.size();
+    points+=frame.count;
+
+    double t=monotonic();
+
+    if (t-tprev >= 1)
+    {
+      std::cout << std::fixed << std::setprecision(1) << frames/(t-tprev) << " fps, " <<
+        static_cast<long>(points/frames) << " points, " <<
+        static_cast<long>(bytes/frames) << " bytes/frame, " <<
+        std::setprecision(2) << bytes/std::max(1.0, points) << " bytes/point, " <<
+        rcgv::getStreamFlagsName(frame.flags) << ", missed " << missed << std::endl;
+
+      frames=0;
+      bytes=0;
+      points=0;
+      tprev=t;
+    }
+  }
+
+  return 0;
+}
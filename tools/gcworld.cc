@@ -34,9 +34,14 @@
  */
 
 #include "gcworld.h"
+#include "timing.h"
 
 #include <string>
 #include <sstream>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <chrono>
 #include <iomanip>
 #include <vector>
 
@@ -45,46 +50,238 @@
 namespace rcgv
 {
 
-GCWorld::GCWorld(int w, int h, const std::shared_ptr<Receiver> &_receiver) : GLWorld(w, h)
+namespace
+{
+
+/*
+  Returns the given file name in the home directory of the user.
+*/
+
+std::string getHomeFile(const char *name)
+{
+  std::string ret;
+
+#ifdef WIN32
+  const char *p=getenv("USERPROFILE");
+  if (p) ret=std::string(p)+"\\"+name;
+#else
+  const char *p=getenv("HOME");
+  if (p) ret=std::string(p)+"/"+name;
+#endif
+
+  return ret;
+}
+
+}
+
+GCWorld::GCWorld(int w, int h, const std::shared_ptr<Source> &_source) : GLWorld(w, h)
 {
   selected=0;
-  show_info=false;
-  receiver=_receiver;
+  info_page=0;
+  fps=0;
+  info_pending=false;
+  source=_source;
   sem_model.increment();
 
+  writer=std::make_shared<PLYWriter>(getHomeFile("capture"));
+  record_count=0;
+
   toggle_texture_on_double_click=false;
   mx=-2;
   my=-2;
 }
 
 GCWorld::~GCWorld()
-{ }
+{
+  // wait until a recording has been written completely
+
+  stopRecording();
+
+  if (finishing)
+  {
+    while (!finishing->isFinished())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    update();
+  }
+}
+
+void GCWorld::update()
+{
+  std::string msg;
+
+  if (writer->getMessage(msg))
+  {
+    setInfoLine(msg.c_str());
+    gvr::GLRedisplay();
+  }
+
+  // report when a stopped recording has been written completely
+
+  if (finishing && finishing->isFinished())
+  {
+    msg="Stored "+finishing->getName()+": "+finishing->getStatusLine();
+    std::cout << msg << std::endl;
+
+    finishing.reset();
+
+    setInfoLine(msg.c_str());
+    gvr::GLRedisplay();
+  }
+}
 
-void GCWorld::addModel(const std::shared_ptr<gvr::Model> &model)
+void GCWorld::startRecording(const std::string &name)
+{
+  if (recorder)
+  {
+    return;
+  }
+
+  std::string file=name;
+
+  // determine name of file if not given
+
+  while (file.size() == 0 && record_count < 1000)
+  {
+    std::ostringstream out;
+    out << getHomeFile("recording") << "_" << std::setw(4) << std::setfill('0') <<
+      record_count++ << ".rcgv";
+
+    std::ifstream in(out.str().c_str());
+    if (!in.is_open())
+    {
+      file=out.str();
+    }
+  }
+
+  try
+  {
+    recorder=std::make_shared<Recorder>(file);
+    source->setRecorder(recorder);
+
+    setInfoLine(("Recording to "+file).c_str());
+  }
+  catch (const std::exception &ex)
+  {
+    setInfoLine(ex.what());
+  }
+}
+
+void GCWorld::stopRecording()
+{
+  if (recorder)
+  {
+    // the backlog is written in the background and the result is reported
+    // by update()
+
+    source->setRecorder(std::shared_ptr<Recorder>());
+    recorder->stop();
+
+    finishing=recorder;
+    recorder.reset();
+
+    setInfoLine(("Finishing "+finishing->getName()).c_str());
+  }
+}
+
+void GCWorld::addModel(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info)
 {
   {
     gutil::Lock lock(sem_model);
     current_model=model;
   }
 
+  // latency is measured when the model has been drawn
+
+  current_info=info;
+  info_pending=true;
+
   GLWorld::addModel(*model.get());
 }
 
-void GCWorld::setFramerate(double _fps)
+void GCWorld::setFramerate(double _fps, const std::string &_load)
 {
   fps=_fps;
+  load=_load;
 
-  if (show_info)
+  if (recorder)
   {
-    std::ostringstream out;
-    out << "Framerate: " << std::setprecision(3) << fps << " Hz";
-    setInfoLine(out.str().c_str());
+    record_status=recorder->getStatusLine();
+  }
+
+  if (info_page > 0)
+  {
+    showInfo();
+  }
+  else if (recorder)
+  {
+    setInfoLine(record_status.c_str());
+  }
+}
+
+void GCWorld::onRedraw()
+{
+  {
+    ScopedTiming timing(TIMING_DRAW);
+    GLWorld::onRedraw();
+  }
+
+  if (info_pending)
+  {
+    addDisplayedFrame(current_info, gutil::ProcTime::monotonic());
+    info_pending=false;
   }
 }
 
 namespace
 {
 
+// number of info pages that are cycled through with key 'i'
+
+const int INFO_PAGES=5;
+
+}
+
+void GCWorld::showInfo()
+{
+  std::ostringstream out;
+
+  switch (info_page)
+  {
+    case 1:
+      out << "Framerate: " << std::setprecision(3) << fps << " Hz";
+      if (load.size() > 0) out << ", load: " << load;
+      if (recorder) out << ", " << record_status;
+      break;
+
+    case 2:
+      out << "Receiver " << getTimingSummary(TIMING_GRAB_WAIT, TIMING_HANDOFF);
+      break;
+
+    case 3:
+      out << "Modeler " << getTimingSummary(TIMING_DECODE, TIMING_NORMALS);
+      break;
+
+    case 4:
+      out << "Viewer " << getTimingSummary(TIMING_MODEL_SWAP, TIMING_DRAW);
+      break;
+
+    case 5:
+      out << getLatencyLine();
+      break;
+
+    default:
+      break;
+  }
+
+  setInfoLine(out.str().c_str());
+}
+
+namespace
+{
+
 int getIndex(const std::vector<std::string> &list, const std::string &value)
 {
   int ret=-1;
@@ -100,17 +297,17 @@ int getIndex(const std::vector<std::string> &list, const std::string &value)
   return ret;
 }
 
-std::string paramEnum2String(const std::shared_ptr<Receiver> &receiver, const char *name)
+std::string paramEnum2String(const std::shared_ptr<Source> &source, const char *name)
 {
   std::ostringstream out;
   bool writable;
 
   out << name;
 
-  if (receiver->getWritable(writable, name))
+  if (source->getWritable(writable, name))
   {
     std::vector<std::string> list;
-    std::string value=receiver->getEnum(name, list);
+    std::string value=source->getEnum(name, list);
 
     out << " [";
 
@@ -137,16 +334,16 @@ std::string paramEnum2String(const std::shared_ptr<Receiver> &receiver, const ch
   return out.str();
 }
 
-std::string paramBoolean2String(const std::shared_ptr<Receiver> &receiver, const char *name)
+std::string paramBoolean2String(const std::shared_ptr<Source> &source, const char *name)
 {
   std::ostringstream out;
   bool writable;
 
   out << name;
 
-  if (receiver->getWritable(writable, name))
+  if (source->getWritable(writable, name))
   {
-    bool value=receiver->getBoolean(name);
+    bool value=source->getBoolean(name);
 
     if (writable)
     {
@@ -187,9 +384,9 @@ void GCWorld::onSpecialKey(int key, int x, int y)
 {
   // disable showing framerate
 
-  if (show_info)
+  if (info_page > 0)
   {
-    show_info=false;
+    info_page=0;
     setInfoLine("");
   }
 
@@ -214,25 +411,25 @@ void GCWorld::onSpecialKey(int key, int x, int y)
         if (key == GLUT_KEY_LEFT)
         {
           std::vector<std::string> slist;
-          std::string value=receiver->getEnum("DepthQuality", slist);
+          std::string value=source->getEnum("DepthQuality", slist);
           int i=getIndex(slist, value);
 
           if (i > 0) i--;
-          if (slist.size() > 0) receiver->setEnum("DepthQuality", slist[i]);
+          if (slist.size() > 0) source->setEnum("DepthQuality", slist[i]);
         }
         else if (key == GLUT_KEY_RIGHT)
         {
           std::vector<std::string> slist;
-          std::string value=receiver->getEnum("DepthQuality", slist);
+          std::string value=source->getEnum("DepthQuality", slist);
           int i=getIndex(slist, value);
 
           if (i+1 < static_cast<int>(slist.size())) i++;
-          if (slist.size() > 0) receiver->setEnum("DepthQuality", slist[i]);
+          if (slist.size() > 0) source->setEnum("DepthQuality", slist[i]);
         }
 
         // show current setting
 
-        setInfoLine(paramEnum2String(receiver, "DepthQuality"));
+        setInfoLine(paramEnum2String(source, "DepthQuality"));
       }
       break;
 
@@ -240,18 +437,18 @@ void GCWorld::onSpecialKey(int key, int x, int y)
       {
         if (key == GLUT_KEY_LEFT)
         {
-          bool value=receiver->getBoolean("DepthStaticScene");
-          if (value) receiver->setBoolean("DepthStaticScene", false);
+          bool value=source->getBoolean("DepthStaticScene");
+          if (value) source->setBoolean("DepthStaticScene", false);
         }
         else if (key == GLUT_KEY_RIGHT)
         {
-          bool value=receiver->getBoolean("DepthStaticScene");
-          if (!value) receiver->setBoolean("DepthStaticScene", true);
+          bool value=source->getBoolean("DepthStaticScene");
+          if (!value) source->setBoolean("DepthStaticScene", true);
         }
 
         // show current setting
 
-        setInfoLine(paramBoolean2String(receiver, "DepthStaticScene"));
+        setInfoLine(paramBoolean2String(source, "DepthStaticScene"));
       }
       break;
 
@@ -259,47 +456,47 @@ void GCWorld::onSpecialKey(int key, int x, int y)
       {
         if (key == GLUT_KEY_LEFT)
         {
-          bool value=receiver->getBoolean("DepthSmooth");
-          if (value) receiver->setBoolean("DepthSmooth", false);
+          bool value=source->getBoolean("DepthSmooth");
+          if (value) source->setBoolean("DepthSmooth", false);
         }
         else if (key == GLUT_KEY_RIGHT)
         {
-          bool value=receiver->getBoolean("DepthSmooth");
-          if (!value) receiver->setBoolean("DepthSmooth", true);
+          bool value=source->getBoolean("DepthSmooth");
+          if (!value) source->setBoolean("DepthSmooth", true);
         }
 
         // show current setting
 
-        setInfoLine(paramBoolean2String(receiver, "DepthSmooth"));
+        setInfoLine(paramBoolean2String(source, "DepthSmooth"));
       }
       break;
 
     case 3: // enum LineSource (LineSelector=Out1)
       {
-        receiver->setEnum("LineSelector", "Out1");
+        source->setEnum("LineSelector", "Out1");
 
         if (key == GLUT_KEY_LEFT)
         {
           std::vector<std::string> slist;
-          std::string value=receiver->getEnum("LineSource", slist);
+          std::string value=source->getEnum("LineSource", slist);
           int i=getIndex(slist, value);
 
           if (i > 0) i--;
-          if (slist.size() > 0) receiver->setEnum("LineSource", slist[i]);
+          if (slist.size() > 0) source->setEnum("LineSource", slist[i]);
         }
         else if (key == GLUT_KEY_RIGHT)
         {
           std::vector<std::string> slist;
-          std::string value=receiver->getEnum("LineSource", slist);
+          std::string value=source->getEnum("LineSource", slist);
           int i=getIndex(slist, value);
 
           if (i+1 < static_cast<int>(slist.size())) i++;
-          if (slist.size() > 0) receiver->setEnum("LineSource", slist[i]);
+          if (slist.size() > 0) source->setEnum("LineSource", slist[i]);
         }
 
         // show current setting
 
-        setInfoLine(paramEnum2String(receiver, "LineSource"));
+        setInfoLine(paramEnum2String(source, "LineSource"));
       }
       break;
   }
@@ -309,66 +506,41 @@ void GCWorld::onKey(unsigned char key, int x, int y)
 {
   if (key == 'c')
   {
-    gutil::Lock lock(sem_model);
+    // the model is written in the background and the result is reported by
+    // update()
 
-    if (current_model)
-    {
-      // get home directory
-
-      std::string fileprefix;
-
-      {
-#ifdef WIN32
-        const char *p=getenv("USERPROFILE");
-        if (p) fileprefix=std::string(p)+"\\capture";
-#else
-        const char *p=getenv("HOME");
-        if (p) fileprefix=std::string(p)+"/capture";
-#endif
-      }
-
-      // determine name of file
-
-      int c=0;
-      std::string name;
-
-      while (name.size() == 0 && c < 1000)
-      {
-        std::ostringstream out;
-        out << fileprefix << "_" << std::setw(4) << std::setfill('0') << c++ << ".ply";
-
-        std::ifstream file(out.str().c_str());
-        if (!file.is_open())
-        {
-          name=out.str();
-        }
-
-        file.close();
-      }
-
-      try
-      {
-        // save PLY
-
-        current_model->savePLY(name.c_str());
+    std::shared_ptr<gvr::Model> model;
 
-        // inform user that file has been saved
+    {
+      gutil::Lock lock(sem_model);
+      model=current_model;
+    }
 
-        setInfoLine(("Saved as "+name).c_str());
-      }
-      catch (const std::exception &)
-      {
-        setInfoLine(("Cannot store file "+name).c_str());
-      }
+    if (model && !writer->capture(model))
+    {
+      setInfoLine("Cannot capture, still writing previous models");
     }
   }
   else if (key == 'i')
   {
-    show_info=true;
+    // cycle through framerate, timings of receiver, modeler and viewer and
+    // latencies
 
-    std::ostringstream out;
-    out << "Framerate: " << std::setprecision(3) << fps << " Hz";
-    setInfoLine(out.str().c_str());
+    info_page=info_page%INFO_PAGES+1;
+    showInfo();
+
+    gvr::GLRedisplay();
+  }
+  else if (key == 'R')
+  {
+    if (recorder)
+    {
+      stopRecording();
+    }
+    else
+    {
+      startRecording();
+    }
 
     gvr::GLRedisplay();
   }
@@ -378,9 +550,9 @@ void GCWorld::onKey(unsigned char key, int x, int y)
   }
   else
   {
-    if (show_info)
+    if (info_page > 0)
     {
-      show_info=false;
+      info_page=0;
       setInfoLine("");
     }
 
@@ -390,7 +562,7 @@ void GCWorld::onKey(unsigned char key, int x, int y)
 
 void GCWorld::onMouseButton(int button, int state, int x, int y)
 {
-  show_info=false;
+  info_page=0;
 
   if (toggle_texture_on_double_click && state == GLUT_DOWN && button == GLUT_LEFT_BUTTON)
   {
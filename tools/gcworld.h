@@ -39,9 +39,13 @@
 #include <gutil/semaphore.h>
 #include <gutil/proctime.h>
 #include <gvr/glworld.h>
-#include "receiver.h"
+#include "source.h"
+#include "framestats.h"
+#include "plywriter.h"
+#include "recorder.h"
 
 #include <memory>
+#include <string>
 
 namespace rcgv
 {
@@ -54,22 +58,48 @@ class GCWorld: public gvr::GLWorld
 {
   public:
 
-    GCWorld(int w, int h, const std::shared_ptr<Receiver> &receiver);
+    GCWorld(int w, int h, const std::shared_ptr<Source> &source);
     virtual ~GCWorld();
 
-    void addModel(const std::shared_ptr<gvr::Model> &model);
-    void setFramerate(double fps);
+    void addModel(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info=FrameInfo());
+    void setFramerate(double fps, const std::string &load=std::string());
 
+    /**
+      Must be called regularly from the GLUT thread for reporting the result
+      of captures that have been written in the background.
+    */
+
+    void update();
+
+    /**
+      Starts recording all synchronized images of the source.
+
+      @param name Name of file. If empty, then an unused name is chosen in the
+                  home directory.
+    */
+
+    void startRecording(const std::string &name=std::string());
+
+    /**
+      Stops recording. The remaining frames are written in the background.
+    */
+
+    void stopRecording();
+
+    virtual void onRedraw();
     virtual void onSpecialKey(int key, int x, int y);
     virtual void onKey(unsigned char key, int x, int y);
     virtual void onMouseButton(int button, int state, int x, int y);
 
   private:
 
+    void showInfo();
+
     int selected;
-    bool show_info;
+    int info_page;
     double fps;
-    std::shared_ptr<Receiver> receiver;
+    std::string load;
+    std::shared_ptr<Source> source;
 
     bool toggle_texture_on_double_click;
     gutil::ProcTime mt;
@@ -77,6 +107,15 @@ class GCWorld: public gvr::GLWorld
 
     gutil::Semaphore sem_model;
     std::shared_ptr<gvr::Model> current_model;
+    std::shared_ptr<PLYWriter> writer;
+
+    int record_count;
+    std::string record_status;
+    std::shared_ptr<Recorder> recorder;
+    std::shared_ptr<Recorder> finishing;
+
+    bool info_pending;
+    FrameInfo current_info;
 };
 
 }
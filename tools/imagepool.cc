@@ -0,0 +1,141 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "imagepool.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace rcgv
+{
+
+ImagePool::ImagePool(size_t _maxbytes)
+{
+  maxbytes=_maxbytes;
+}
+
+std::shared_ptr<const RawImage> ImagePool::copy(const rcg::Buffer *buffer, uint32_t part)
+{
+  return copy(static_cast<const uint8_t *>(buffer->getBase(part)), buffer->getSize(part),
+    buffer->getWidth(part), buffer->getHeight(part), buffer->getPixelFormat(part),
+    buffer->isBigEndian(), buffer->getXPadding(part), buffer->getTimestampNS());
+}
+
+std::shared_ptr<const RawImage> ImagePool::copy(const RawImage &image)
+{
+  size_t size=(RawImage::getLineSize(image.getWidth(), image.getPixelFormat())+
+    image.getXPadding())*image.getHeight();
+
+  return copy(image.getPixels(), size, image.getWidth(), image.getHeight(),
+    image.getPixelFormat(), image.isBigEndian(), image.getXPadding(), image.getTimestampNS());
+}
+
+std::shared_ptr<const RawImage> ImagePool::copy(const uint8_t *pixels, size_t size,
+  size_t width, size_t height, uint64_t format, bool bigendian, size_t xpadding,
+  uint64_t timestamp)
+{
+  size_t line=RawImage::getLineSize(width, format);
+
+  if (line == 0 || (line+xpadding)*height > size)
+  {
+    return std::shared_ptr<const RawImage>();
+  }
+
+  size=(line+xpadding)*height;
+
+  // find an image that is not leased, preferably one with enough memory
+
+  size_t leased=0;
+  std::shared_ptr<RawImage> ret;
+
+  for (size_t i=0; i<image.size(); i++)
+  {
+    if (image[i].use_count() == 1)
+    {
+      if (!ret || (ret->getCapacity() < size && image[i]->getCapacity() >= size))
+      {
+        ret=image[i];
+      }
+    }
+    else
+    {
+      leased+=image[i]->getCapacity();
+    }
+  }
+
+  if (leased+size > maxbytes)
+  {
+    return std::shared_ptr<const RawImage>();
+  }
+
+  if (ret)
+  {
+    // synchronize with the thread that dropped the last reference
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  else
+  {
+    ret=std::make_shared<RawImage>(0, 0, 0);
+    image.push_back(ret);
+  }
+
+  // the image and its memory are only allocated during warm-up or if the
+  // image size grows
+
+  ret->resize(width, height, format, bigendian, xpadding);
+  memcpy(ret->getData(), pixels, size);
+
+  ret->setTimestampNS(timestamp);
+
+  return ret;
+}
+
+size_t ImagePool::getLeasedBytes()
+{
+  size_t ret=0;
+
+  for (size_t i=0; i<image.size(); i++)
+  {
+    if (image[i].use_count() > 1)
+    {
+      ret+=image[i]->getCapacity();
+    }
+  }
+
+  return ret;
+}
+
+}
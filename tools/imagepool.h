@@ -0,0 +1,119 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_IMAGEPOOL
+#define RC_GENICAM_VIEWER_IMAGEPOOL
+
+#include "rawimage.h"
+
+#include <rc_genicam_api/buffer.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Pool of images for copying the images that are received from the device.
+  This is a copy into recycled memory, not zero-copy leasing of the GenTL
+  buffers, because rc_genicam_api requeues a buffer to the stream with the
+  next call to grab(), so that the pixels must be taken out of the buffer
+  before. Instead of allocating a new image for each copy, the images are
+  leased to the synchronizer, modeler and recorder and recycled as soon as
+  all references to them have been dropped. The amount of memory that is
+  leased at the same time is limited.
+
+  The pool must only be used by one thread, but images can be released by
+  any thread.
+*/
+
+class ImagePool
+{
+  public:
+
+    /**
+      Creates the pool.
+
+      @param maxbytes Maximum number of bytes that can be leased at the same
+                      time.
+    */
+
+    ImagePool(size_t maxbytes=1024*1024*1024);
+
+    /**
+      Copies the pixels of a part of the buffer into recycled memory.
+
+      @param buffer Buffer that has been grabbed.
+      @param part   Part of the buffer that contains an image.
+      @return       Image, or null if the budget of leased memory is
+                    exhausted or the pixel format is not supported.
+    */
+
+    std::shared_ptr<const RawImage> copy(const rcg::Buffer *buffer, uint32_t part);
+
+    /**
+      Copies the pixels of an image into recycled memory, e.g. for simulated
+      images.
+
+      @param image Image.
+      @return      Image, or null if the budget of leased memory is
+                   exhausted or the pixel format is not supported.
+    */
+
+    std::shared_ptr<const RawImage> copy(const RawImage &image);
+
+    /**
+      Returns the number of bytes that are currently leased.
+    */
+
+    size_t getLeasedBytes();
+
+  private:
+
+    ImagePool(const ImagePool &);
+    ImagePool &operator=(const ImagePool &);
+
+    std::shared_ptr<const RawImage> copy(const uint8_t *pixels, size_t size, size_t width,
+      size_t height, uint64_t format, bool bigendian, size_t xpadding, uint64_t timestamp);
+
+    size_t maxbytes;
+    std::vector<std::shared_ptr<RawImage> > image;
+};
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mappedfile.h"
+
+#include <gutil/exception.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rcgv
+{
+
+#ifdef WIN32
+
+MappedFile::MappedFile(const std::string &name)
+{
+  data=0;
+  size=0;
+  mapping=0;
+
+  file=CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    throw gutil::IOException("Cannot open file: "+name);
+  }
+
+  LARGE_INTEGER s;
+  if (!GetFileSizeEx(file, &s))
+  {
+    CloseHandle(file);
+    throw gutil::IOException("Cannot determine size of file: "+name);
+  }
+
+  size=static_cast<uint64_t>(s.QuadPart);
+
+  if (size > 0)
+  {
+    mapping=CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+
+    if (mapping != 0)
+    {
+      data=static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+
+    if (data == 0)
+    {
+      if (mapping != 0) CloseHandle(mapping);
+      CloseHandle(file);
+      throw gutil::IOException("Cannot map file: "+name);
+    }
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (data != 0) UnmapViewOfFile(data);
+  if (mapping != 0) CloseHandle(mapping);
+  CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &name)
+{
+  data=0;
+  size=0;
+
+  int fd=open(name.c_str(), O_RDONLY);
+
+  if (fd < 0)
+  {
+    throw gutil::IOException("Cannot open file: "+name);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    throw gutil::IOException("Cannot determine size of file: "+name);
+  }
+
+  size=static_cast<uint64_t>(st.st_size);
+
+  if (size > 0)
+  {
+    void *p=mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (p == MAP_FAILED)
+    {
+      ::close(fd);
+      throw gutil::IOException("Cannot map file: "+name);
+    }
+
+    // the file is mainly read sequentially
+
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    data=static_cast<const uint8_t *>(p);
+  }
+
+  // the mapping stays valid after closing the file descriptor
+
+  ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data != 0)
+  {
+    munmap(const_cast<uint8_t *>(data), size);
+  }
+}
+
+#endif
+
+}
@@ -34,471 +34,787 @@
  */
 
 #include "modeler.h"
+#include "convert.h"
+#include "alloccount.h"
+#include "timing.h"
 
 #include <rc_genicam_api/pixel_formats.h>
 
 #include <gvr/coloredmesh.h>
-#include <gimage/size.h>
+#include <gutil/proctime.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <cmath>
 
 namespace rcgv
 {
 
-Modeler::Modeler() : in(1), sem(1)
+/*
+  Lookup tables for reconstructing vertices from raw disparity values. The
+  tables only depend on the camera parameters, the disparity scaling and the
+  image size, so that they are kept until one of them changes.
+*/
+
+struct DisparityLUT
 {
-  // start background thread for streaming images
+  struct Entry
+  {
+    float d;      // disparity
+    float s;      // t/d, i.e. scale factor from image to camera coordinates
+    float z;      // depth
+    float size;   // scan size
+    float err;    // scan error
+    bool valid;
+  };
+
+  double f, t, scale, offset;
+  int inv;
+  long width, height;
+
+  std::vector<Entry> entry;   // one entry for each raw 16 bit value
+  std::vector<float> xcol;    // i-w2 for each column
+  std::vector<float> yrow;    // k-h2 for each row
+
+  bool matches(double _f, double _t, int _inv, double _scale, double _offset, long _width,
+               long _height) const
+  {
+    return f == _f && t == _t && inv == _inv && scale == _scale && offset == _offset &&
+      width == _width && height == _height;
+  }
+};
 
-  running=true;
-  thread.create(*this);
-}
+namespace
+{
 
-Modeler::~Modeler()
+/*
+  Returns a pointer to row k of the raw disparity image as 16 bit values in
+  native byte order. The raw row is used directly if possible. Otherwise, it
+  is decoded into the given line buffer.
+*/
+
+const uint16_t *getDispRow(std::vector<uint16_t> &line, const RawImage &disp, long k,
+                           int inv, int *valid=0)
 {
-  // stop grabbing thread
+  static const uint16_t one=1;
+  static const bool little_endian=(*reinterpret_cast<const uint8_t *>(&one) == 1);
 
-  running=false;
-  in.push(std::shared_ptr<InputMsg>());
-  thread.join();
+  const size_t width=disp.getWidth();
+  const uint8_t *row=disp.getPixels()+
+    static_cast<size_t>(k)*(width*sizeof(uint16_t)+disp.getXPadding());
+
+  if (valid == 0 && disp.isBigEndian() != little_endian &&
+    (reinterpret_cast<uintptr_t>(row)&(sizeof(uint16_t)-1)) == 0)
+  {
+    return reinterpret_cast<const uint16_t *>(row);
+  }
+
+  line.resize(width);
+
+  int n=decodeDisparityRow(line.data(), row, width, disp.isBigEndian(), inv);
+
+  if (valid != 0)
+  {
+    *valid=n;
+  }
+
+  return line.data();
 }
 
-void Modeler::process(double f, double t, double inv, double scale, double offset,
-  std::shared_ptr<const rcg::Image> left, std::shared_ptr<const rcg::Image> disp)
+/*
+  Stores the number of valid disparities of each row.
+*/
+
+void countValidDisp(std::vector<int> &rowvalid, std::vector<uint16_t> &line,
+                    const RawImage &disp, int inv)
 {
-  std::shared_ptr<InputMsg> msg=std::make_shared<InputMsg>();
+  const long height=static_cast<long>(disp.getHeight());
 
-  msg->f=f;
-  msg->t=t;
-  msg->inv=inv;
-  msg->scale=scale;
-  msg->offset=offset;
-  msg->left=left;
-  msg->disp=disp;
+  rowvalid.resize(static_cast<size_t>(height));
 
-  in.push(msg);
+  for (long k=0; k<height; k++)
+  {
+    getDispRow(line, disp, k, inv, &rowvalid[static_cast<size_t>(k)]);
+  }
 }
 
-std::shared_ptr<gvr::Model> Modeler::nextModel()
+std::shared_ptr<const DisparityLUT> createDisparityLUT(double f, double t, int inv,
+  double scale, double offset, long width, long height)
 {
-  gutil::Lock lock(sem);
+  std::shared_ptr<DisparityLUT> lut=std::make_shared<DisparityLUT>();
 
-  std::shared_ptr<gvr::Model> ret=model;
-  model.reset();
+  lut->f=f;
+  lut->t=t;
+  lut->inv=inv;
+  lut->scale=scale;
+  lut->offset=offset;
+  lut->width=width;
+  lut->height=height;
 
-  return ret;
+  double w2=width/2.0-0.5;
+  double h2=height/2.0-0.5;
+
+  f*=width;
+
+  lut->entry.resize(65536);
+  for (int v=0; v<65536; v++)
+  {
+    DisparityLUT::Entry &e=lut->entry[static_cast<size_t>(v)];
+
+    if (v != inv)
+    {
+      double d=v*scale+offset;
+      double s=t/std::max(d, 0.1);
+
+      // the scan size is twice the distance to the pixel corner
+
+      e.d=static_cast<float>(d);
+      e.s=static_cast<float>(s);
+      e.z=static_cast<float>(f*s);
+      e.size=static_cast<float>(std::sqrt(2.0)*s);
+      e.err=static_cast<float>(f*s-f*t/(d+0.5));
+      e.valid=true;
+    }
+    else
+    {
+      e.d=std::numeric_limits<float>::infinity();
+      e.s=e.z=e.size=e.err=0;
+      e.valid=false;
+    }
+  }
+
+  lut->xcol.resize(static_cast<size_t>(width));
+  for (long i=0; i<width; i++)
+  {
+    lut->xcol[static_cast<size_t>(i)]=static_cast<float>(i-w2);
+  }
+
+  lut->yrow.resize(static_cast<size_t>(height));
+  for (long k=0; k<height; k++)
+  {
+    lut->yrow[static_cast<size_t>(k)]=static_cast<float>(k-h2);
+  }
+
+  return lut;
 }
 
-namespace
+/*
+  Horizontal band of the disparity image that is meshed independently of
+  other bands. The band creates the vertices of its rows and the triangles
+  between each of its rows and the row above, including the first row of the
+  band and the last row of the previous band.
+*/
+
+struct MeshBand
 {
+  long k0, k1;                  // rows of the band
+  int vertex;                   // index of first vertex of band
+  int tindex;                   // index of first triangle of band
+  std::vector<int> triangle;    // scratch buffer with triangles of band
+  std::vector<int> line0;       // vertex indices of previous row
+  std::vector<int> line1;       // vertex indices of current row
+  std::vector<uint16_t> dline0; // disparities of previous row if decoded
+  std::vector<uint16_t> dline1; // disparities of current row if decoded
+  ColorConverter color;
+};
 
-void getImage(gimage::ImageU8 &out, const std::shared_ptr<const rcg::Image> &in)
+/*
+  Creates colors, vertices and triangles of a band in one row-streaming pass
+  over the disparity image. Only the current and the previous row are needed
+  for creating triangles. Triangles are collected in the scratch buffer of the
+  band, since their number is only known after the pass.
+*/
+
+void createBand(gvr::ColoredMesh &mesh, MeshBand &band, const RawImage &disp,
+                const std::vector<int> &rowvalid, const DisparityLUT &lut, float dstep)
 {
-  size_t width=in->getWidth();
-  size_t height=in->getHeight();
-  size_t px=in->getXPadding();
+  const long width=static_cast<long>(disp.getWidth());
+  const DisparityLUT::Entry *entry=lut.entry.data();
 
-  const uint8_t *ps=in->getPixels();
+  // lines with vertex indices of the previous and current row
 
-  if (in->getPixelFormat() == Mono8)
-  {
-    out.setSize(static_cast<long>(width), static_cast<long>(height), 1);
+  band.line0.resize(static_cast<size_t>(width));
+  band.line1.resize(static_cast<size_t>(width));
+
+  int *l0=band.line0.data();
+  int *l1=band.line1.data();
+
+  const uint16_t *drow0=0;
+
+  band.triangle.clear();
+
+  int n=band.vertex;
 
-    gutil::uint8 *pt=out.getPtr(0, 0, 0);
+  // get vertex indices of the last row of the previous band for stitching
+  // both bands together
 
-    for (size_t k=0; k<height; k++)
+  if (band.k0 > 0)
+  {
+    drow0=getDispRow(band.dline0, disp, band.k0-1, lut.inv);
+
+    int j=n-rowvalid[static_cast<size_t>(band.k0-1)];
+    for (long i=0; i<width; i++)
     {
-      for (size_t i=0; i<width; i++)
+      l0[i]=-1;
+
+      if (entry[drow0[i]].valid)
       {
-        *pt++=*ps++;
+        l0[i]=j++;
       }
-
-      ps+=px;
     }
   }
-  else if (in->getPixelFormat() == RGB8)
+
+  for (long k=band.k0; k<band.k1; k++)
   {
-    out.setSize(static_cast<long>(width), static_cast<long>(height), 3);
+    const uint16_t *drow1=getDispRow(band.dline1, disp, k, lut.inv);
+    const float y=lut.yrow[static_cast<size_t>(k)];
 
-    gutil::uint8 *rt=out.getPtr(0, 0, 0);
-    gutil::uint8 *gt=out.getPtr(0, 0, 1);
-    gutil::uint8 *bt=out.getPtr(0, 0, 2);
+    band.color.setRow(k);
 
-    for (size_t k=0; k<height; k++)
+    for (long i=0; i<width; i++)
     {
-      for (size_t i=0; i<width; i++)
+      // store color and vertex of valid pixels
+
+      const DisparityLUT::Entry &e=entry[drow1[i]];
+
+      l1[i]=-1;
+
+      if (e.valid)
       {
-        *rt++=*ps++;
-        *gt++=*ps++;
-        *bt++=*ps++;
-      }
+        uint8_t rgb[3];
+        band.color.get(rgb, i);
 
-      ps+=px;
-    }
-  }
-  else if (in->getPixelFormat() == YCbCr411_8)
-  {
-    out.setSize(static_cast<long>(width), static_cast<long>(height), 3);
+        mesh.setColorComp(n, 0, rgb[0]);
+        mesh.setColorComp(n, 1, rgb[1]);
+        mesh.setColorComp(n, 2, rgb[2]);
 
-    size_t pstep=(width>>2)*6+px;
+        mesh.setVertexComp(n, 0, lut.xcol[static_cast<size_t>(i)]*e.s);
+        mesh.setVertexComp(n, 1, y*e.s);
+        mesh.setVertexComp(n, 2, e.z);
 
-    gutil::uint8 *rt=out.getPtr(0, 0, 0);
-    gutil::uint8 *gt=out.getPtr(0, 0, 1);
-    gutil::uint8 *bt=out.getPtr(0, 0, 2);
+        mesh.setScanSize(n, e.size);
+        mesh.setScanError(n, e.err);
+        mesh.setScanConf(n, 1.0f);
 
-    for (size_t k=0; k<height; k++)
-    {
-      for (size_t i=0; i<width; i+=4)
+        l1[i]=n++;
+      }
+
+      // create triangles between previous and current row
+
+      if (drow0 != 0 && i > 0)
       {
-        uint8_t rgb[12];
-        rcg::convYCbCr411toQuadRGB(rgb, ps, static_cast<int>(i));
+        float dmin=std::numeric_limits<float>::max();
+        float dmax=-std::numeric_limits<float>::max();
+        int   valid=0;
+        int   ff[4];
 
-        for (int j=0; j<12; j+=3)
+        if (l0[i-1] >= 0)
         {
-          *rt++=rgb[j];
-          *gt++=rgb[j+1];
-          *bt++=rgb[j+2];
+          dmin=std::min(dmin, entry[drow0[i-1]].d);
+          dmax=std::max(dmax, entry[drow0[i-1]].d);
+          ff[valid++]=l0[i-1];
         }
-      }
 
-      ps+=pstep;
+        if (l1[i-1] >= 0)
+        {
+          dmin=std::min(dmin, entry[drow1[i-1]].d);
+          dmax=std::max(dmax, entry[drow1[i-1]].d);
+          ff[valid++]=l1[i-1];
+        }
+
+        if (l1[i] >= 0)
+        {
+          dmin=std::min(dmin, entry[drow1[i]].d);
+          dmax=std::max(dmax, entry[drow1[i]].d);
+          ff[valid++]=l1[i];
+        }
+
+        if (l0[i] >= 0)
+        {
+          dmin=std::min(dmin, entry[drow0[i]].d);
+          dmax=std::max(dmax, entry[drow0[i]].d);
+          ff[valid++]=l0[i];
+        }
+
+        if (valid >= 3 && dmax-dmin <= dstep)
+        {
+          band.triangle.push_back(ff[0]);
+          band.triangle.push_back(ff[1]);
+          band.triangle.push_back(ff[2]);
+
+          if (valid == 4)
+          {
+            band.triangle.push_back(ff[2]);
+            band.triangle.push_back(ff[3]);
+            band.triangle.push_back(ff[0]);
+          }
+        }
+      }
     }
+
+    std::swap(l0, l1);
+    std::swap(band.dline0, band.dline1);
+    drow0=drow1;
+  }
+}
+
+/*
+  Copies the triangles of a band into the mesh.
+*/
+
+void storeBandTriangles(gvr::ColoredMesh &mesh, const MeshBand &band)
+{
+  int tn=static_cast<int>(band.triangle.size()/3);
+
+  const int *tp=band.triangle.data();
+  for (int j=band.tindex; j<band.tindex+tn; j++)
+  {
+    mesh.setTriangleIndex(j, 0, static_cast<unsigned int>(*tp++));
+    mesh.setTriangleIndex(j, 1, static_cast<unsigned int>(*tp++));
+    mesh.setTriangleIndex(j, 2, static_cast<unsigned int>(*tp++));
   }
 }
 
-int getDisp(gimage::ImageFloat &dout, const std::shared_ptr<const rcg::Image> &din,
-                 double inv, double scale, double offset)
+}
+
+/*
+  Data of a frame that is passed through the stages of the pipeline. Frames
+  are recycled, so that their scratch buffers are reused.
+*/
+
+struct Modeler::Frame
+{
+  std::shared_ptr<InputMsg> msg;
+  std::shared_ptr<const DisparityLUT> lut;
+  std::vector<uint16_t> line;   // scratch buffer for decoding disparities
+  std::vector<int> rowvalid;    // number of valid disparities per row
+  std::vector<MeshBand> band;   // horizontal bands for parallel meshing
+  int n;                        // number of vertices
+  std::shared_ptr<gvr::ColoredMesh> mesh;
+  FrameInfo info;
+};
+
+namespace
 {
-  const int iinv=static_cast<int>(inv);
 
-  size_t width=din->getWidth();
-  size_t height=din->getHeight();
+// number of frames that can be in flight, i.e. one per stage
+
+const int FRAME_COUNT=3;
+
+// number of pooled input messages and meshes, which covers the frames in
+// flight, the input queue, the published model and the models of the viewer
+
+const int POOL_COUNT=FRAME_COUNT+3;
 
-  const uint8_t *dps=din->getPixels();
-  size_t dstep=din->getWidth()*sizeof(uint16_t)+din->getXPadding();
+}
 
-  dout.setSize(static_cast<long>(width), static_cast<long>(height), 1);
-  float *dpt=dout.getPtr(0, 0, 0);
+Modeler::Modeler(int threads, bool _lossless) : msg_pool(POOL_COUNT), mesh_pool(POOL_COUNT),
+  in(1), free_frames(FRAME_COUNT), decoded(1), meshed(1), sem(1), sem_model_free(1),
+  sem_stat(1), workers(threads)
+{
+  lossless=_lossless;
+  alloc=0;
+  mesh_alloc=0;
 
-  int ret=0;
-  if (din->isBigEndian()) // big endian
+  for (int i=0; i<FRAME_COUNT; i++)
   {
-    for (size_t k=0; k<height; k++)
-    {
-      int j=0;
-      for (size_t i=0; i<width; i++)
-      {
-        int val=(static_cast<int>(dps[j])<<8)|dps[j+1];
-        j+=2;
+    free_frames.push(std::make_shared<Frame>());
+  }
 
-        float d=std::numeric_limits<float>::infinity();
-        if (val != iinv)
-        {
-          d=static_cast<float>(val*scale+offset);
-          ret++;
-        }
+  for (int i=0; i<STAGE_COUNT; i++)
+  {
+    busy[i]=0;
+  }
 
-        *dpt++=d;
-      }
+  tstat=gutil::ProcTime::monotonic();
 
-      dps+=dstep;
-    }
+  // start background threads of all stages
+
+  running=true;
+
+  for (int i=0; i<STAGE_COUNT; i++)
+  {
+    stage.push_back(std::make_shared<Stage>(*this, static_cast<StageID>(i)));
+    stage.back()->thread.create(*stage.back());
   }
-  else // little endian
+}
+
+Modeler::~Modeler()
+{
+  // stop all stages, which pass the empty message through the pipeline
+
+  running=false;
+
+  if (lossless)
   {
-    for (size_t k=0; k<height; k++)
+    // models are not polled anymore, so that publishing must not block for
+    // the frames in flight, the pending input and the empty message
+
+    for (int i=0; i<FRAME_COUNT+2; i++)
     {
-      int j=0;
-      for (size_t i=0; i<width; i++)
-      {
-        int val=(static_cast<int>(dps[j+1])<<8)|dps[j];
-        j+=2;
+      sem_model_free.increment();
+    }
 
-        float d=std::numeric_limits<float>::infinity();
-        if (val != iinv)
-        {
-          d=static_cast<float>(val*scale+offset);
-          ret++;
-        }
+    in.push(std::shared_ptr<InputMsg>());
+  }
+  else
+  {
+    in.replace(std::shared_ptr<InputMsg>());
+  }
 
-        *dpt++=d;
-      }
+  for (size_t i=0; i<stage.size(); i++)
+  {
+    stage[i]->thread.join();
+  }
+}
 
-      dps+=dstep;
-    }
+void Modeler::process(double f, double t, double inv, double scale, double offset,
+  std::shared_ptr<const RawImage> left, std::shared_ptr<const RawImage> disp, double grabbed)
+{
+  // rows of the disparity image are read with 16 bit per pixel, so that
+  // other formats would lead to access outside of the image
+
+  if (!left || !disp ||
+      (disp->getPixelFormat() != Coord3D_C16 && disp->getPixelFormat() != Mono16))
+  {
+    return;
+  }
+
+  uint64_t a=getThreadAllocationCount();
+
+  std::shared_ptr<InputMsg> msg=msg_pool.get();
+
+  msg->f=f;
+  msg->t=t;
+  msg->inv=inv;
+  msg->scale=scale;
+  msg->offset=offset;
+  msg->grabbed=(grabbed > 0 ? grabbed : gutil::ProcTime::monotonic());
+  msg->left=left;
+  msg->disp=disp;
+
+  incCounter(COUNT_INPUT);
+
+  if (lossless)
+  {
+    in.push(msg);
+  }
+  else if (in.replace(msg))
+  {
+    incCounter(COUNT_INPUT_DROPPED);
+  }
+
+  alloc+=getThreadAllocationCount()-a;
+}
+
+std::shared_ptr<gvr::Model> Modeler::nextModel(FrameInfo *info)
+{
+  gutil::Lock lock(sem);
+
+  std::shared_ptr<gvr::Model> ret=model;
+  model.reset();
+
+  if (info != 0)
+  {
+    *info=model_info;
+  }
+
+  if (lossless && ret)
+  {
+    sem_model_free.increment();
   }
 
   return ret;
 }
 
+void Modeler::getStageOccupancy(std::vector<std::string> &name,
+                                std::vector<double> &occupancy)
+{
+  static const char *stage_name[]={"decode", "mesh", "publish"};
+
+  gutil::Lock lock(sem_stat);
+
+  double t=gutil::ProcTime::monotonic();
+
+  name.clear();
+  occupancy.clear();
+
+  for (int i=0; i<STAGE_COUNT; i++)
+  {
+    name.push_back(stage_name[i]);
+    occupancy.push_back(t > tstat ? std::min(1.0, busy[i]/(t-tstat)) : 0.0);
+    busy[i]=0;
+  }
+
+  tstat=t;
 }
 
-void Modeler::run()
+uint64_t Modeler::getAllocationCount()
 {
-  while (running)
+  return alloc+workers.getAllocationCount();
+}
+
+uint64_t Modeler::getMeshAllocationCount()
+{
+  return mesh_alloc;
+}
+
+void Modeler::addBusyTime(StageID id, double t)
+{
+  gutil::Lock lock(sem_stat);
+  busy[id]+=t;
+}
+
+void Modeler::Stage::run()
+{
+  switch (id)
   {
-    // wait for input message
+    case DECODE:
+      parent.decode();
+      break;
+
+    case MESH:
+      parent.mesh();
+      break;
+
+    case PUBLISH:
+      parent.publish();
+      break;
 
+    default:
+      break;
+  }
+}
+
+void Modeler::decode()
+{
+  while (true)
+  {
+    // wait for a free frame and then for the next input message, so that
+    // the freshest input is taken if the pipeline is full
+
+    std::shared_ptr<Frame> frame=free_frames.pop();
     std::shared_ptr<InputMsg> msg=in.pop();
 
-    if (msg)
+    if (!msg)
     {
-      float dstep=1.0f;
+      decoded.push(std::shared_ptr<Frame>());
+      break;
+    }
 
-      // convert disparity image and get number of valid points
+    double t0=gutil::ProcTime::monotonic();
+    uint64_t a=getThreadAllocationCount();
 
-      gimage::ImageFloat disp;
-      int n=getDisp(disp, msg->disp, msg->inv, msg->scale, msg->offset);
+    frame->msg=msg;
 
-      // convert intensity or color image and resize to disparity image
+    frame->info.timestamp=msg->disp->getTimestampNS();
+    frame->info.grabbed=msg->grabbed;
+    frame->info.started=t0;
 
-      gimage::ImageU8 fimage;
-      getImage(fimage, msg->left);
+    // get number of valid points per row from the raw disparity image
 
-      gimage::ImageU8 dsimage;
-      gimage::ImageU8 *image=&fimage;
+    const int inv=static_cast<int>(msg->inv);
 
-      {
-        int ds=(fimage.getWidth()+disp.getWidth()-1)/disp.getWidth();
+    countValidDisp(frame->rowvalid, frame->line, *msg->disp, inv);
 
-        if (ds > 1)
-        {
-          dsimage=gimage::downscaleImage(fimage, ds);
-          image=&dsimage;
-          fimage.setSize(0, 0, 0);
-        }
-      }
+    // rebuild lookup tables only if parameters have changed, frames that are
+    // still in flight keep their own reference to the previous tables
 
-      // create mesh
+    const long width=static_cast<long>(msg->disp->getWidth());
+    const long height=static_cast<long>(msg->disp->getHeight());
 
-      gvr::ColoredMesh *mesh=new gvr::ColoredMesh();
-      mesh->resizeVertexList(n, true, false);
+    if (!lut || !lut->matches(msg->f, msg->t, inv, msg->scale, msg->offset, width, height))
+    {
+      lut=createDisparityLUT(msg->f, msg->t, inv, msg->scale, msg->offset, width, height);
+    }
 
-      // store colors
+    frame->lut=lut;
 
-      n=0;
-      if (image->getDepth() == 3)
-      {
-        for (long k=0; k<image->getHeight(); k++)
-        {
-          for (long i=0; i<image->getWidth(); i++)
-          {
-            if (disp.isValid(i, k))
-            {
-              mesh->setColorComp(n, 0, image->get(i, k, 0));
-              mesh->setColorComp(n, 1, image->get(i, k, 1));
-              mesh->setColorComp(n, 2, image->get(i, k, 2));
-              n++;
-            }
-          }
-        }
-      }
-      else
+    // split disparity image into horizontal bands, one for each thread,
+    // and compute the index of the first vertex of each band
+
+    const long nband=std::max(1L, std::min(static_cast<long>(workers.getThreadCount()),
+      height/4));
+
+    frame->band.resize(static_cast<size_t>(nband));
+
+    int n=0;
+    for (long j=0; j<nband; j++)
+    {
+      MeshBand &b=frame->band[static_cast<size_t>(j)];
+
+      b.k0=j*height/nband;
+      b.k1=(j+1)*height/nband;
+      b.vertex=n;
+
+      for (long k=b.k0; k<b.k1; k++)
       {
-        for (long k=0; k<image->getHeight(); k++)
-        {
-          for (long i=0; i<image->getWidth(); i++)
-          {
-            if (disp.isValid(i, k))
-            {
-              gutil::uint8 c=image->get(i, k, 0);
-              mesh->setColorComp(n, 0, c);
-              mesh->setColorComp(n, 1, c);
-              mesh->setColorComp(n, 2, c);
-              n++;
-            }
-          }
-        }
+        n+=frame->rowvalid[static_cast<size_t>(k)];
       }
 
-      // reconstruct and store vertices
+      // colors are taken directly from the intensity or color image at the
+      // resolution of the disparity image
 
-      double w2=disp.getWidth()/2.0-0.5;
-      double h2=disp.getHeight()/2.0-0.5;
+      b.color.init(msg->left->getPixels(), msg->left->getPixelFormat(),
+        msg->left->getWidth(), msg->left->getHeight(), msg->left->getXPadding(),
+        msg->disp->getWidth());
+    }
 
-      double f=msg->f*disp.getWidth();
+    frame->n=n;
 
-      n=0;
-      for (long k=0; k<disp.getHeight(); k++)
-      {
-        for (long i=0; i<disp.getWidth(); i++)
-        {
-          double d=disp.get(i, k);
-          if (disp.isValidS(static_cast<float>(d)))
-          {
-            gmath::Vector3d P;
+    alloc+=getThreadAllocationCount()-a;
+    double t1=gutil::ProcTime::monotonic();
 
-            double s=msg->t/std::max(d, 0.1);
+    addTiming(TIMING_DECODE, t1-t0);
+    addBusyTime(DECODE, t1-t0);
 
-            P[0]=(i-w2)*s;
-            P[1]=(k-h2)*s;
-            P[2]=f*s;
+    decoded.push(frame);
+  }
+}
 
-            mesh->setVertexComp(n, 0, static_cast<float>(P[0]));
-            mesh->setVertexComp(n, 1, static_cast<float>(P[1]));
-            mesh->setVertexComp(n, 2, static_cast<float>(P[2]));
+void Modeler::mesh()
+{
+  while (true)
+  {
+    std::shared_ptr<Frame> frame=decoded.pop();
 
-            double dx=(i+0.5-w2)*s-P[0];
-            double dy=(k+0.5-h2)*s-P[1];
+    if (!frame)
+    {
+      meshed.push(frame);
+      break;
+    }
 
-            mesh->setScanSize(n, static_cast<float>(2*std::sqrt(dx*dx+dy*dy)));
+    double t0=gutil::ProcTime::monotonic();
+    uint64_t a=getThreadAllocationCount();
 
-            double dz=P[2]-f*msg->t/(d+0.5);
+    // create colors, vertices and triangles of all bands in parallel, the
+    // job functions only capture one reference for avoiding heap allocation
+    // in std::function
 
-            mesh->setScanError(n, static_cast<float>(dz));
-            mesh->setScanConf(n, 1.0f);
+    frame->mesh=mesh_pool.get();
 
-            n++;
-          }
-        }
-      }
+    uint64_t m=getThreadAllocationCount();
+    frame->mesh->resizeVertexList(frame->n, true, false);
+    m=getThreadAllocationCount()-m;
 
-      // count number of triangles
+    workers.run(static_cast<int>(frame->band.size()), [&frame](int j)
+    {
+      const float dstep=1.0f;
 
-      int tn=0;
-      for (long k=1; k<disp.getHeight(); k++)
-      {
-        for (long i=1; i<disp.getWidth(); i++)
-        {
-          float dmin=std::numeric_limits<float>::max();
-          float dmax=-std::numeric_limits<float>::max();
-          int   valid=0;
+      createBand(*frame->mesh, frame->band[static_cast<size_t>(j)], *frame->msg->disp,
+        frame->rowvalid, *frame->lut, dstep);
+    });
 
-          for (int kk=0; kk<2; kk++)
-          {
-            for (int ii=0; ii<2; ii++)
-            {
-              if (disp.isValid(i-ii, k-kk))
-              {
-                dmin=std::min(dmin, disp.get(i-ii, k-kk));
-                dmax=std::max(dmax, disp.get(i-ii, k-kk));
-                valid++;
-              }
-            }
-          }
+    double t1=gutil::ProcTime::monotonic();
 
-          if (valid >= 3 && dmax-dmin <= dstep)
-          {
-            tn+=valid-2;
-          }
-        }
-      }
+    // store triangles of all bands at their offset in the mesh
 
-      mesh->resizeTriangleList(tn);
+    int tn=0;
+    for (size_t j=0; j<frame->band.size(); j++)
+    {
+      frame->band[j].tindex=tn;
+      tn+=static_cast<int>(frame->band[j].triangle.size()/3);
+    }
 
-      // create triangles
+    uint64_t mt=getThreadAllocationCount();
+    frame->mesh->resizeTriangleList(tn);
+    m+=getThreadAllocationCount()-mt;
 
-      std::vector<int> line0(static_cast<unsigned int>(disp.getWidth()));
-      std::vector<int> line1(static_cast<unsigned int>(disp.getWidth()));
-      std::vector<int> *l0=&line0;
-      std::vector<int> *l1=&line1;
+    workers.run(static_cast<int>(frame->band.size()), [&frame](int j)
+    {
+      storeBandTriangles(*frame->mesh, frame->band[static_cast<size_t>(j)]);
+    });
 
-      n=0;
-      tn=0;
+    alloc+=getThreadAllocationCount()-a-m;
+    mesh_alloc+=m;
 
-      for (long i=0; i<disp.getWidth(); i++)
-      {
-        l1->at(i)=-1;
+    double t2=gutil::ProcTime::monotonic();
 
-        if (disp.isValid(i, 0))
-        {
-          l1->at(i)=n++;
-        }
-      }
+    addTiming(TIMING_MESH, t1-t0);
+    addTiming(TIMING_TRIANGLES, t2-t1);
+    addBusyTime(MESH, t2-t0);
 
-      for (long k=1; k<disp.getHeight(); k++)
-      {
-        std::vector<int> *t=l0;
-        l0=l1;
-        l1=t;
+    meshed.push(frame);
+  }
+}
 
-        l1->at(0)=-1;
+void Modeler::publish()
+{
+  while (true)
+  {
+    std::shared_ptr<Frame> frame=meshed.pop();
 
-        if (disp.isValid(0, k))
-        {
-          l1->at(0)=n++;
-        }
+    if (!frame)
+    {
+      break;
+    }
 
-        for (long i=1; i<disp.getWidth(); i++)
-        {
-          float dmin=std::numeric_limits<float>::max();
-          float dmax=-std::numeric_limits<float>::max();
-          int   valid=0;
+    double t0=gutil::ProcTime::monotonic();
+    uint64_t a=getThreadAllocationCount();
 
-          l1->at(static_cast<unsigned int>(i))=-1;
+    std::shared_ptr<gvr::ColoredMesh> cmesh=frame->mesh;
 
-          if (disp.isValid(i, k))
-          {
-            l1->at(i)=n++;
-          }
+    // the input images are not needed anymore, the message and the mesh
+    // return to their pools when the last reference is dropped
 
-          for (int kk=0; kk<2; kk++)
-          {
-            for (int ii=0; ii<2; ii++)
-            {
-              if (disp.isValid(i-ii, k-kk))
-              {
-                dmin=std::min(dmin, disp.get(i-ii, k-kk));
-                dmax=std::max(dmax, disp.get(i-ii, k-kk));
-                valid++;
-              }
-            }
-          }
+    frame->msg->left.reset();
+    frame->msg->disp.reset();
+    frame->msg.reset();
+    frame->lut.reset();
+    frame->mesh.reset();
 
-          if (valid >= 3 && dmax-dmin <= dstep)
-          {
-            int j=0;
-            int ff[4];
-
-            if (l0->at(i-1) >= 0)
-            {
-              ff[j++]=l0->at(i-1);
-            }
-
-            if (l1->at(i-1) >= 0)
-            {
-              ff[j++]=l1->at(i-1);
-            }
-
-            if (l1->at(i) >= 0)
-            {
-              ff[j++]=l1->at(i);
-            }
-
-            if (l0->at(i) >= 0)
-            {
-              ff[j++]=l0->at(i);
-            }
-
-            mesh->setTriangleIndex(tn, 0, ff[0]);
-            mesh->setTriangleIndex(tn, 1, ff[1]);
-            mesh->setTriangleIndex(tn, 2, ff[2]);
-            tn++;
-
-            if (j == 4)
-            {
-              mesh->setTriangleIndex(tn, 0, ff[2]);
-              mesh->setTriangleIndex(tn, 1, ff[3]);
-              mesh->setTriangleIndex(tn, 2, ff[0]);
-              tn++;
-            }
-          }
-        }
-      }
+    // compute normals
+
+    uint64_t m=getThreadAllocationCount();
 
-      // compute normals
+    {
+      ScopedTiming timing(TIMING_NORMALS);
+      cmesh->recalculateNormals();
+    }
 
-      mesh->recalculateNormals();
+    m=getThreadAllocationCount()-m;
 
-      // set default camera
+    // set default camera
+
+    cmesh->setDefCameraRT(gmath::Matrix33d(), gmath::Vector3d());
+
+    // make model available for polling, in lossless mode after the
+    // previous model has been polled
+
+    if (lossless)
+    {
+      sem_model_free.decrement();
+    }
 
-      mesh->setDefCameraRT(gmath::Matrix33d(), gmath::Vector3d());
+    frame->info.finished=gutil::ProcTime::monotonic();
 
-      // make model available for polling
+    {
+      gutil::Lock lock(sem);
 
+      if (model)
       {
-        gutil::Lock lock(sem);
-        model.reset(mesh);
+        incCounter(COUNT_MODELS_DROPPED);
       }
+
+      model=cmesh;
+      model_info=frame->info;
     }
+
+    incCounter(COUNT_MODELS);
+    addLatency(LATENCY_PIPELINE, frame->info.finished-frame->info.grabbed);
+
+    cmesh.reset();
+
+    alloc+=getThreadAllocationCount()-a-m;
+    mesh_alloc+=m;
+    addBusyTime(PUBLISH, gutil::ProcTime::monotonic()-t0);
+
+    free_frames.push(frame);
   }
+
+  running=false;
 }
 
 }
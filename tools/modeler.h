@@ -36,56 +36,120 @@
 #ifndef RC_GENICAM_VIEWER_MODELER
 #define RC_GENICAM_VIEWER_MODELER
 
-#include <gimage/image.h>
-#include <rc_genicam_api/image.h>
+#include "workers.h"
+#include "boundedqueue.h"
+#include "pool.h"
+#include "rawimage.h"
+#include "framestats.h"
 
 #include <gvr/model.h>
 #include <gutil/thread.h>
-#include <gutil/msgqueue.h>
 #include <gutil/semaphore.h>
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
+
+namespace gvr
+{
+class ColoredMesh;
+}
 
 namespace rcgv
 {
 
+struct DisparityLUT;
+
 /**
   Modeler object gets synchronized intensity and disparity images and creates
-  a colored mesh object in a background thread.
+  a colored mesh object in background threads. Processing is split into a
+  pipeline of stages, each running in its own thread, so that several frames
+  can be in flight. Models are published in the order of the input.
 */
 
-class Modeler: public gutil::ThreadFunction
+class Modeler
 {
   public:
 
-    Modeler();
+    /**
+      Creates the modeler and starts the background threads.
+
+      @param threads  Number of threads for creating the mesh. 0 for using the
+                      number of cores.
+      @param lossless If true, then process() blocks instead of overriding
+                      unprocessed data and models are kept until they are
+                      polled by nextModel(). This is meant for benchmarks.
+    */
+
+    Modeler(int threads=0, bool lossless=false);
     ~Modeler();
 
     /**
       Provides synchronized data for creating the next model. This call may
       override a previously given model if it was not processed fast enough.
+      The disparity image must be Coord3D_C16 or Mono16, otherwise the data
+      is ignored.
+
+      @param grabbed Monotonic host time when the images were grabbed. 0 for
+                     the current time.
     */
 
     void process(double f, double t, double inv, double scale, double offset,
-                 std::shared_ptr<const rcg::Image> left,
-                 std::shared_ptr<const rcg::Image> disp);
+                 std::shared_ptr<const RawImage> left,
+                 std::shared_ptr<const RawImage> disp, double grabbed=0);
 
     /**
       Returns the next model if available.
+
+      @param info Optional pointer for returning the times of the frame.
     */
 
-    std::shared_ptr<gvr::Model> nextModel();
+    std::shared_ptr<gvr::Model> nextModel(FrameInfo *info=0);
 
     /**
-      Returns true if the background thread is running.
+      Returns true if the background threads are running.
     */
 
     bool isRunning() { return running; }
 
+    /**
+      Returns the names of the pipeline stages and the fraction of time that
+      each stage was busy since the last call.
+
+      @param name      Names of stages.
+      @param occupancy Fraction of busy time between 0 and 1 of each stage.
+    */
+
+    void getStageOccupancy(std::vector<std::string> &name, std::vector<double> &occupancy);
+
+    /**
+      Returns the number of heap allocations of all threads of the pipeline
+      since construction, without the allocations inside the pooled meshes.
+      Messages, frames and meshes are recycled, so that this number should
+      stop growing after warm-up. All counts are 0 if the program does not
+      count allocations, see isAllocationCounting().
+    */
+
+    uint64_t getAllocationCount();
+
+    /**
+      Returns the number of heap allocations that cvkit made for the vertex,
+      color, normal and triangle lists of the pooled meshes. These lists are
+      allocated when a pooled mesh is used for the first time, which may
+      happen after warm-up if the consumer holds models longer than before,
+      and, depending on the mesh implementation of cvkit, whenever the number
+      of vertices or triangles changes. They are not included in
+      getAllocationCount().
+    */
+
+    uint64_t getMeshAllocationCount();
+
   private:
 
-    void run();
+    Modeler(const Modeler &);
+    Modeler &operator=(const Modeler &);
 
     struct InputMsg
     {
@@ -94,16 +158,61 @@ class Modeler: public gutil::ThreadFunction
       double inv;
       double scale;
       double offset;
-      std::shared_ptr<const rcg::Image> left;
-      std::shared_ptr<const rcg::Image> disp;
+      double grabbed;
+      std::shared_ptr<const RawImage> left;
+      std::shared_ptr<const RawImage> disp;
+    };
+
+    struct Frame;
+
+    enum StageID { DECODE, MESH, PUBLISH, STAGE_COUNT };
+
+    class Stage: public gutil::ThreadFunction
+    {
+      public:
+
+        Stage(Modeler &_parent, StageID _id) : parent(_parent), id(_id) { }
+        void run();
+
+        Modeler &parent;
+        StageID id;
+        gutil::Thread thread;
     };
 
-    gutil::MsgQueueReplace<std::shared_ptr<InputMsg> > in;
+    void decode();
+    void mesh();
+    void publish();
+
+    void addBusyTime(StageID id, double t);
+
+    Pool<InputMsg> msg_pool;
+    Pool<gvr::ColoredMesh> mesh_pool;
+
+    BoundedQueue<std::shared_ptr<InputMsg> > in;
+
+    std::shared_ptr<const DisparityLUT> lut;
+
+    BoundedQueue<std::shared_ptr<Frame> > free_frames;
+    BoundedQueue<std::shared_ptr<Frame> > decoded;
+    BoundedQueue<std::shared_ptr<Frame> > meshed;
+
+    bool lossless;
 
     gutil::Semaphore sem;
+    gutil::Semaphore sem_model_free;
     std::shared_ptr<gvr::Model> model;
+    FrameInfo model_info;
+
+    gutil::Semaphore sem_stat;
+    double busy[STAGE_COUNT];
+    double tstat;
+
+    std::atomic<uint64_t> alloc;
+    std::atomic<uint64_t> mesh_alloc;
+
+    Workers workers;
 
-    gutil::Thread thread;
+    std::vector<std::shared_ptr<Stage> > stage;
     std::atomic_bool running;
 };
 
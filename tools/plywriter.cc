@@ -0,0 +1,144 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "plywriter.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace rcgv
+{
+
+PLYWriter::PLYWriter(const std::string &_prefix, int n) : queue(n), sem_msg(1)
+{
+  prefix=_prefix;
+  count=0;
+  nmax=n;
+
+  thread.create(*this);
+}
+
+PLYWriter::~PLYWriter()
+{
+  queue.push(std::shared_ptr<gvr::Model>());
+  thread.join();
+}
+
+bool PLYWriter::capture(const std::shared_ptr<gvr::Model> &model)
+{
+  // models are only queued from one thread, so that the queue cannot become
+  // full between checking and pushing
+
+  if (queue.size() >= nmax)
+  {
+    return false;
+  }
+
+  queue.push(model);
+
+  return true;
+}
+
+bool PLYWriter::getMessage(std::string &msg)
+{
+  gutil::Lock lock(sem_msg);
+
+  if (msg_list.size() > 0)
+  {
+    msg=msg_list.front();
+    msg_list.erase(msg_list.begin());
+    return true;
+  }
+
+  return false;
+}
+
+std::string PLYWriter::getNextName()
+{
+  // probing for existing files starts at the last used number
+
+  while (count < 1000)
+  {
+    std::ostringstream out;
+    out << prefix << "_" << std::setw(4) << std::setfill('0') << count++ << ".ply";
+
+    std::ifstream file(out.str().c_str());
+    if (!file.is_open())
+    {
+      return out.str();
+    }
+  }
+
+  return std::string();
+}
+
+void PLYWriter::run()
+{
+  while (true)
+  {
+    std::shared_ptr<gvr::Model> model=queue.pop();
+
+    if (!model)
+    {
+      break;
+    }
+
+    std::string name=getNextName();
+    std::string msg;
+
+    try
+    {
+      if (name.size() == 0)
+      {
+        msg="Cannot find unused file name for "+prefix;
+      }
+      else
+      {
+        model->savePLY(name.c_str());
+        msg="Saved as "+name;
+      }
+    }
+    catch (const std::exception &)
+    {
+      msg="Cannot store file "+name;
+    }
+
+    gutil::Lock lock(sem_msg);
+    msg_list.push_back(msg);
+  }
+}
+
+}
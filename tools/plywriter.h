@@ -0,0 +1,117 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_PLYWRITER
+#define RC_GENICAM_VIEWER_PLYWRITER
+
+#include "boundedqueue.h"
+
+#include <gvr/model.h>
+#include <gutil/thread.h>
+#include <gutil/semaphore.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Writes models as PLY files in a background thread, so that capturing does
+  not block rendering. Files are named <prefix>_<nnnn>.ply, with the first
+  number that does not exist yet.
+*/
+
+class PLYWriter: public gutil::ThreadFunction
+{
+  public:
+
+    /**
+      Starts the background thread.
+
+      @param prefix Path and prefix of file names.
+      @param n      Maximum number of models waiting for being written.
+    */
+
+    PLYWriter(const std::string &prefix, int n=4);
+
+    /**
+      Writes all pending models and stops the background thread.
+    */
+
+    ~PLYWriter();
+
+    /**
+      Queues the model for writing. Only a reference of the model is kept.
+
+      @return False if the queue is full and the model is not written.
+    */
+
+    bool capture(const std::shared_ptr<gvr::Model> &model);
+
+    /**
+      Returns the next message about a finished or failed capture.
+
+      @param msg Message for the user.
+      @return    False if there is no message.
+    */
+
+    bool getMessage(std::string &msg);
+
+    void run();
+
+  private:
+
+    PLYWriter(const PLYWriter &);
+    PLYWriter &operator=(const PLYWriter &);
+
+    std::string getNextName();
+
+    std::string prefix;
+    int count;
+    int nmax;
+
+    BoundedQueue<std::shared_ptr<gvr::Model> > queue;
+
+    gutil::Semaphore sem_msg;
+    std::vector<std::string> msg_list;
+
+    gutil::Thread thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_POOL
+#define RC_GENICAM_VIEWER_POOL
+
+#include <gutil/semaphore.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Pool of recycled objects. An object is handed out again as soon as all
+  references outside of the pool have been dropped, so that objects return
+  to the pool without any explicit call and without allocating a new control
+  block for each use.
+*/
+
+template<class T> class Pool
+{
+  public:
+
+    /**
+      Creates the pool with the given initial number of objects.
+    */
+
+    Pool(int n) : sem(1)
+    {
+      for (int i=0; i<n; i++)
+      {
+        item.push_back(std::make_shared<T>());
+      }
+    }
+
+    /**
+      Returns an object that is not used outside of the pool. The pool is
+      enlarged if all objects are in use. The state of the object is the one
+      of its last use.
+    */
+
+    std::shared_ptr<T> get()
+    {
+      gutil::Lock lock(sem);
+
+      for (size_t i=0; i<item.size(); i++)
+      {
+        if (item[i].use_count() == 1)
+        {
+          // synchronize with the thread that dropped the last reference
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          return item[i];
+        }
+      }
+
+      item.push_back(std::make_shared<T>());
+
+      return item.back();
+    }
+
+    /**
+      Returns the number of objects that the pool holds.
+    */
+
+    int size()
+    {
+      gutil::Lock lock(sem);
+      return static_cast<int>(item.size());
+    }
+
+  private:
+
+    Pool(const Pool &);
+    Pool &operator=(const Pool &);
+
+    gutil::Semaphore sem;
+    std::vector<std::shared_ptr<T> > item;
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rawimage.h"
+
+#include <rc_genicam_api/pixel_formats.h>
+
+namespace rcgv
+{
+
+RawImage::RawImage(const std::shared_ptr<const rcg::Image> &image)
+{
+  owner=image;
+
+  pixels=image->getPixels();
+  width=image->getWidth();
+  height=image->getHeight();
+  xpadding=image->getXPadding();
+  format=image->getPixelFormat();
+  bigendian=image->isBigEndian();
+  timestamp=image->getTimestampNS();
+}
+
+RawImage::RawImage(size_t _width, size_t _height, uint64_t _format, bool _bigendian,
+                   size_t _xpadding)
+{
+  resize(_width, _height, _format, _bigendian, _xpadding);
+}
+
+RawImage::RawImage(const std::shared_ptr<const void> &_owner, const uint8_t *_pixels,
+                   size_t _width, size_t _height, uint64_t _format, bool _bigendian,
+                   size_t _xpadding)
+{
+  owner=_owner;
+
+  pixels=_pixels;
+  width=_width;
+  height=_height;
+  xpadding=_xpadding;
+  format=_format;
+  bigendian=_bigendian;
+  timestamp=0;
+}
+
+void RawImage::resize(size_t _width, size_t _height, uint64_t _format, bool _bigendian,
+                      size_t _xpadding)
+{
+  width=_width;
+  height=_height;
+  xpadding=_xpadding;
+  format=_format;
+  bigendian=_bigendian;
+  timestamp=0;
+
+  data.resize((getLineSize(width, format)+xpadding)*height);
+  pixels=data.data();
+}
+
+size_t RawImage::getLineSize(size_t width, uint64_t format)
+{
+  switch (format)
+  {
+    case Mono8:
+      return width;
+
+    case RGB8:
+      return 3*width;
+
+    case YCbCr411_8:
+      return (width>>2)*6;
+
+    case Mono16:
+    case Coord3D_C16:
+      return 2*width;
+
+    default:
+      return 0;
+  }
+}
+
+}
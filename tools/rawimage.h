@@ -0,0 +1,146 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_RAWIMAGE
+#define RC_GENICAM_VIEWER_RAWIMAGE
+
+#include <rc_genicam_api/image.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Image with raw pixels as they are delivered by the device. The image either
+  refers to an image of rc_genicam_api without copying its pixels or it owns
+  its pixel memory, e.g. for synthetic images, or it refers to memory of
+  another object, e.g. for memory mapped recordings.
+*/
+
+class RawImage
+{
+  public:
+
+    /**
+      Refers to the pixels of the given image, which is kept alive as long as
+      this object exists.
+    */
+
+    RawImage(const std::shared_ptr<const rcg::Image> &image);
+
+    /**
+      Creates an image with own, uninitialized pixel memory.
+
+      @param width     Width of image in pixels.
+      @param height    Height of image in pixels.
+      @param format    Pixel format, i.e. Mono8, RGB8, YCbCr411_8 or Mono16.
+      @param bigendian True if 16 bit values are stored in big endian.
+      @param xpadding  Number of padding bytes at the end of each row.
+    */
+
+    RawImage(size_t width, size_t height, uint64_t format, bool bigendian=false,
+             size_t xpadding=0);
+
+    /**
+      Refers to pixels in memory that is owned by the given object, e.g. a
+      memory mapped file, which is kept alive as long as this object exists.
+    */
+
+    RawImage(const std::shared_ptr<const void> &owner, const uint8_t *pixels,
+             size_t width, size_t height, uint64_t format, bool bigendian=false,
+             size_t xpadding=0);
+
+    /**
+      Changes size and format of an image with own pixel memory, e.g. for
+      recycling the image. The memory is only reallocated if it grows. The
+      pixels are uninitialized and the timestamp is set to 0.
+    */
+
+    void resize(size_t width, size_t height, uint64_t format, bool bigendian=false,
+                size_t xpadding=0);
+
+    /**
+      Returns the number of bytes of own pixel memory, including memory that
+      is reserved for growing.
+    */
+
+    size_t getCapacity() const { return data.capacity(); }
+
+    /**
+      Returns the number of bytes of one row without padding, or 0 if the
+      pixel format is not supported.
+    */
+
+    static size_t getLineSize(size_t width, uint64_t format);
+
+    const uint8_t *getPixels() const { return pixels; }
+
+    /**
+      Returns the pixel memory for writing or 0 if the memory is owned by
+      another object.
+    */
+
+    uint8_t *getData() { return data.size() > 0 ? data.data() : 0; }
+
+    size_t getWidth() const { return width; }
+    size_t getHeight() const { return height; }
+    size_t getXPadding() const { return xpadding; }
+    uint64_t getPixelFormat() const { return format; }
+    bool isBigEndian() const { return bigendian; }
+
+    uint64_t getTimestampNS() const { return timestamp; }
+    void setTimestampNS(uint64_t t) { timestamp=t; }
+
+  private:
+
+    RawImage(const RawImage &);
+    RawImage &operator=(const RawImage &);
+
+    std::shared_ptr<const void> owner;
+    std::vector<uint8_t> data;
+
+    const uint8_t *pixels;
+    size_t width, height, xpadding;
+    uint64_t format;
+    bool bigendian;
+    uint64_t timestamp;
+};
+
+}
+
+#endif
@@ -34,14 +34,15 @@
  */
 
 #include "receiver.h"
+#include "framematcher.h"
 #include "selectionwindow.h"
+#include "timing.h"
+#include "framestats.h"
 
 #include <rc_genicam_api/system.h>
 #include <rc_genicam_api/interface.h>
 #include <rc_genicam_api/stream.h>
 #include <rc_genicam_api/buffer.h>
-#include <rc_genicam_api/image.h>
-#include <rc_genicam_api/imagelist.h>
 #include <rc_genicam_api/config.h>
 
 #include <rc_genicam_api/pixel_formats.h>
@@ -127,13 +128,18 @@ std::vector<std::shared_ptr<rcg::Device> > getDevices(std::vector<std::string> &
 }
 
 Receiver::Receiver(std::shared_ptr<Modeler> _modeler, const char *device,
-  double _timeout, const std::vector<std::string> &genicam_param)
+  double _timeout, const std::vector<std::string> &genicam_param, bool _multipart) :
+  control(*this)
 {
-  sem_nodemap.increment();
+  sem_recorder.increment();
+
+  running=false;
+  control_running=false;
 
   modeler=_modeler;
 
   timeout=_timeout;
+  multipart=false;
 
   // find specific device accross all systems and interfaces and open it
 
@@ -275,16 +281,50 @@ Receiver::Receiver(std::shared_ptr<Modeler> _modeler, const char *device,
 
   rcg::setString(nodemap, "AcquisitionAlternateFilter", "OnlyLow");
 
-  // try getting synchronized data (which only has an effect if the device
-  // and GenTL producer support multipart)
+  // request intensity and disparity images of the same frame in one buffer
+  // if multipart is wanted, otherwise each image comes in its own buffer and
+  // images are synchronized by their timestamps
+
+  if (_multipart)
+  {
+    multipart=rcg::setEnum(nodemap, "AcquisitionMultiPartMode", "SynchronizedComponents",
+      false);
+
+    if (multipart)
+    {
+      multipart=(rcg::getEnum(nodemap, "AcquisitionMultiPartMode", false) ==
+        "SynchronizedComponents");
+    }
+
+    if (!multipart)
+    {
+      std::cerr << "Device does not support SynchronizedComponents, matching timestamps instead"
+        << std::endl;
+    }
+  }
 
-  rcg::setString(nodemap, "AcquisitionMultiPartMode", "SingleComponent");
+  if (!multipart)
+  {
+    rcg::setString(nodemap, "AcquisitionMultiPartMode", "SingleComponent");
+  }
 
   // set depth acquisition mode to continuous
 
   rcg::setString(nodemap, "DepthAcquisitionMode", "Continuous");
 
-  // start background thread for streaming images
+  // resolve nodes that are needed for every image
+
+  initNodeCache();
+
+  // get interval for sending heartbeats to GEV devices
+
+  heartbeat_interval=rcg::getInteger(nodemap, "GevHeartbeatTimeout", 0, 0, false)/2000.0;
+  check_connection=false;
+
+  // start background threads for controlling the device and streaming images
+
+  control_running=true;
+  control.thread.create(control);
 
   running=true;
   thread.create(*this);
@@ -305,6 +345,20 @@ void Receiver::close()
     thread.join();
   }
 
+  if (control_running)
+  {
+    // stop control thread after the grabbing thread, which may request
+    // checking the connection
+
+    {
+      std::lock_guard<std::mutex> lock(control_mutex);
+      control_running=false;
+    }
+
+    control_cv.notify_one();
+    control.thread.join();
+  }
+
   // closing the communication to the device
 
   if (dev)
@@ -313,6 +367,7 @@ void Receiver::close()
   }
 
   modeler.reset();
+  setRecorder(std::shared_ptr<Recorder>());
   dev.reset();
   nodemap.reset();
 
@@ -321,92 +376,425 @@ void Receiver::close()
   rcg::System::clearSystems();
 }
 
+void Receiver::setRecorder(const std::shared_ptr<Recorder> &_recorder)
+{
+  gutil::Lock lock(sem_recorder);
+  recorder=_recorder;
+}
+
 bool Receiver::getWritable(bool &writable, const char *name)
 {
-  gutil::Lock lock(sem_nodemap);
   bool ret=false;
 
-  if (nodemap)
+  call([&]()
   {
-    try
+    if (nodemap)
     {
-      GenApi::INode *node=nodemap->_GetNode(name);
-
-      if (node != 0)
+      try
       {
-        if (GenApi::IsReadable(node))
+        GenApi::INode *node=nodemap->_GetNode(name);
+
+        if (node != 0)
         {
-          writable=GenApi::IsWritable(node);
-          ret=true;
+          if (GenApi::IsReadable(node))
+          {
+            writable=GenApi::IsWritable(node);
+            ret=true;
+          }
         }
       }
+      catch (const GENICAM_NAMESPACE::GenericException &)
+      { }
     }
-    catch (const GENICAM_NAMESPACE::GenericException &)
-    { }
-  }
+  });
 
   return ret;
 }
 
 bool Receiver::getBoolean(const char *name)
 {
-  gutil::Lock lock(sem_nodemap);
+  bool ret=false;
 
-  if (nodemap)
+  call([&]()
   {
-    return rcg::getBoolean(nodemap, name);
-  }
+    if (nodemap)
+    {
+      ret=rcg::getBoolean(nodemap, name);
+    }
+  });
 
-  return false;
+  return ret;
 }
 
 void Receiver::setBoolean(const char *name, bool value)
 {
-  gutil::Lock lock(sem_nodemap);
-
-  if (nodemap)
+  call([&]()
   {
-    rcg::setBoolean(nodemap, name, value);
-  }
+    if (nodemap)
+    {
+      rcg::setBoolean(nodemap, name, value);
+    }
+  });
 }
 
 std::string Receiver::getEnum(const char *name, std::vector<std::string> &list)
 {
-  gutil::Lock lock(sem_nodemap);
+  std::string ret;
 
-  if (nodemap)
+  call([&]()
   {
-    return rcg::getEnum(nodemap, name, list);
-  }
+    if (nodemap)
+    {
+      ret=rcg::getEnum(nodemap, name, list);
+    }
+  });
 
-  return std::string();
+  return ret;
 }
 
 void Receiver::setEnum(const char *name, const std::string &value)
 {
-  gutil::Lock lock(sem_nodemap);
+  call([&]()
+  {
+    if (nodemap)
+    {
+      rcg::setEnum(nodemap, name, value.c_str());
+
+      // switch timestamp tolerance if switching between exposure alternate
+      // and other modes
 
-  if (nodemap)
+      if (std::string(name) == "LineSource")
+      {
+        if (value == "ExposureAlternateActive")
+        {
+          tol=250*1000*1000; // set maximum tolerance to 250 ms
+        }
+        else
+        {
+          tol=0;
+        }
+      }
+    }
+  });
+}
+
+void Receiver::call(const std::function<void()> &f)
+{
+  Command cmd;
+  cmd.f=&f;
+
+  gutil::Semaphore done(0);
+  cmd.done=&done;
+
+  std::exception_ptr error;
+  cmd.error=&error;
+
+  {
+    std::lock_guard<std::mutex> lock(control_mutex);
+
+    if (!control_running)
+    {
+      // nothing can interfere if the control thread is not running
+
+      cmd.done=0;
+    }
+    else
+    {
+      commands.push_back(cmd);
+    }
+  }
+
+  if (cmd.done == 0)
   {
-    rcg::setEnum(nodemap, name, value.c_str());
+    f();
+    return;
+  }
+
+  control_cv.notify_one();
+  done.decrement();
+
+  // pass exceptions to the caller
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+void Receiver::runControl()
+{
+  double last_heartbeat=gutil::ProcTime::monotonic();
+
+  std::unique_lock<std::mutex> lock(control_mutex);
+
+  // pending commands are still executed after stopping, since their callers
+  // are waiting
+
+  while (control_running || commands.size() > 0)
+  {
+    // wait for commands or until the next heartbeat is due
+
+    double wait=0.5;
+
+    if (heartbeat_interval > 0)
+    {
+      wait=std::max(0.0, last_heartbeat+heartbeat_interval-gutil::ProcTime::monotonic());
+    }
 
-    // switch timestamp tolerance if switching between exposure alternate and
-    // other modes
+    control_cv.wait_for(lock, std::chrono::microseconds(static_cast<int64_t>(1000000*wait)),
+      [this]() { return !control_running || commands.size() > 0 || check_connection; });
 
-    if (std::string(name) == "LineSource")
+    // execute all pending commands
+
+    while (commands.size() > 0)
     {
-      if (value == "ExposureAlternateActive")
+      Command cmd=commands.front();
+      commands.pop_front();
+
+      lock.unlock();
+
+      try
       {
-        tol=250*1000*1000; // set maximum tolerance to 250 ms
+        (*cmd.f)();
       }
-      else
+      catch (...)
+      {
+        *cmd.error=std::current_exception();
+      }
+
+      cmd.done->increment();
+
+      lock.lock();
+    }
+
+    // ensure heartbeat for GEV devices and check if connection is still
+    // there if no images are received
+
+    bool heartbeat=(heartbeat_interval > 0 &&
+      last_heartbeat+heartbeat_interval <= gutil::ProcTime::monotonic());
+
+    if (control_running && (heartbeat || check_connection))
+    {
+      check_connection=false;
+
+      lock.unlock();
+
+      try
+      {
+        if (nodemap)
+        {
+          rcg::setEnum(nodemap, "LineSelector", "Out1", true);
+          rcg::getString(nodemap, "LineSource", true, true);
+        }
+      }
+      catch (const std::exception &ex)
+      {
+        std::cerr << ex.what() << std::endl;
+        running=false;
+      }
+      catch (const GENICAM_NAMESPACE::GenericException &ex)
+      {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        running=false;
+      }
+
+      last_heartbeat=gutil::ProcTime::monotonic();
+
+      lock.lock();
+    }
+  }
+}
+
+void Receiver::initNodeCache()
+{
+  // nodes of chunk data for getting the current out1 mode
+
+  chunk_line_selector=nodemap->_GetNode("ChunkLineSelector");
+  chunk_line_source=nodemap->_GetNode("ChunkLineSource");
+  chunk_out1=-1;
+  chunk_line_source_name.clear();
+
+  try
+  {
+    if (chunk_line_selector.IsValid())
+    {
+      GenApi::IEnumEntry *entry=chunk_line_selector->GetEntryByName("Out1");
+
+      if (entry != 0)
       {
-        tol=0;
+        chunk_out1=entry->GetValue();
+      }
+    }
+
+    if (chunk_line_source.IsValid())
+    {
+      std::vector<std::string> list;
+      rcg::getEnum(nodemap, "ChunkLineSource", list, false);
+
+      for (size_t i=0; i<list.size(); i++)
+      {
+        GenApi::IEnumEntry *entry=chunk_line_source->GetEntryByName(list[i].c_str());
+
+        if (entry != 0)
+        {
+          chunk_line_source_name[entry->GetValue()]=list[i];
+        }
       }
     }
   }
+  catch (const GENICAM_NAMESPACE::GenericException &)
+  { }
+
+  // mapping from ids of components to their names
+
+  component_name.clear();
+
+  if (nodemap->_GetNode("ComponentIDValue") != 0)
+  {
+    std::vector<std::string> component;
+    std::string current=rcg::getEnum(nodemap, "ComponentSelector", component, false);
+
+    for (size_t i=0; i<component.size(); i++)
+    {
+      if (rcg::setEnum(nodemap, "ComponentSelector", component[i].c_str(), false))
+      {
+        int64_t id=rcg::getInteger(nodemap, "ComponentIDValue", 0, 0, false);
+
+        if (id >= 0)
+        {
+          component_name[static_cast<uint64_t>(id)]=component[i];
+        }
+      }
+    }
+
+    if (current.size() > 0)
+    {
+      rcg::setEnum(nodemap, "ComponentSelector", current.c_str(), false);
+    }
+
+    // ids must be unique, otherwise the complete search is always used
+
+    if (component_name.size() != component.size())
+    {
+      component_name.clear();
+    }
+  }
+}
+
+const std::string &Receiver::getOut1Mode()
+{
+  // reading the out1 mode from chunk data is allowed to fail to support
+  // rc_visard / rc_cube < 22.07.0
+
+  static const std::string empty;
+
+  if (chunk_line_source.IsValid())
+  {
+    try
+    {
+      if (chunk_out1 >= 0 && chunk_line_selector->GetIntValue() != chunk_out1)
+      {
+        chunk_line_selector->SetIntValue(chunk_out1);
+      }
+
+      std::map<int64_t, std::string>::const_iterator it=
+        chunk_line_source_name.find(chunk_line_source->GetIntValue());
+
+      if (it != chunk_line_source_name.end())
+      {
+        return it->second;
+      }
+    }
+    catch (const GENICAM_NAMESPACE::GenericException &)
+    { }
+  }
+
+  return empty;
 }
 
+std::string Receiver::getComponent(const rcg::Buffer *buffer, uint32_t part)
+{
+  std::map<uint64_t, std::string>::const_iterator it=
+    component_name.find(buffer->getPartSourceID(part));
+
+  if (it != component_name.end())
+  {
+    return it->second;
+  }
+
+  // fall back to the pixel format, e.g. for devices without component ids,
+  // since the grabbing thread must not access the device
+
+  switch (buffer->getPixelFormat(part))
+  {
+    case Mono8:
+    case RGB8:
+    case YCbCr411_8:
+      return "Intensity";
+
+    case Coord3D_C16:
+      return "Disparity";
+
+    default:
+      return std::string();
+  }
+}
+
+/*
+  Gives the frame matcher access to the parts of a buffer of the device.
+*/
+
+class Receiver::GrabbedBuffer: public BufferParts
+{
+  public:
+
+    GrabbedBuffer(Receiver &_parent, const rcg::Buffer *_buffer) :
+      parent(_parent), buffer(_buffer) { }
+
+    uint32_t getNumberOfParts()
+    {
+      return static_cast<uint32_t>(buffer->getNumberOfParts());
+    }
+
+    bool getComponent(Synchronizer::Component &component, uint32_t part)
+    {
+      if (buffer->getImagePresent(part))
+      {
+        std::string name=parent.getComponent(buffer, part);
+
+        if (name == "Intensity" || name == "Disparity")
+        {
+          component=(name == "Intensity" ? Synchronizer::INTENSITY :
+            Synchronizer::DISPARITY);
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    const std::string &getOut1Mode(uint32_t)
+    {
+      // get current out1 mode from chunk data (allowed to fail to support
+      // rc_visard / rc_cube < 22.07.0)
+
+      return parent.getOut1Mode();
+    }
+
+    std::shared_ptr<const RawImage> copyImage(ImagePool &pool, uint32_t part)
+    {
+      // the pixels are copied into recycled memory, since the buffer is
+      // requeued with the next call to grab()
+
+      return pool.copy(buffer, part);
+    }
+
+  private:
+
+    Receiver &parent;
+    const rcg::Buffer *buffer;
+};
+
 void Receiver::run()
 {
   try
@@ -423,105 +811,69 @@ void Receiver::run()
       stream[0]->attachBuffers(true);
       stream[0]->startStreaming();
 
-      // prepare buffers for time synchronization of images
+      // prepare pairing of images of the same frame
 
-      rcg::ImageList left_list(100);
-      rcg::ImageList disp_list(25);
+      FrameMatcher matcher(multipart);
 
       double last_grabbed=gutil::ProcTime::monotonic();
-      double last_heartbeat=last_grabbed;
-      double heartbeat_timeout=rcg::getInteger(nodemap, "GevHeartbeatTimeout", 0, 0, false)/2000.0;
+      double tgrabbed=0;
+      double tsync=0;
+
+      // hand the data over to the modeler and queue it for recording, which
+      // never blocks
+
+      auto handOver=[&](const std::shared_ptr<const RawImage> &left,
+                        const std::shared_ptr<const RawImage> &disp)
+      {
+        double thandoff=gutil::ProcTime::monotonic();
+        addTiming(TIMING_SYNC, thandoff-tsync);
+
+        modeler->process(f, t, inv, scale, offset, left, disp, tgrabbed);
+
+        {
+          gutil::Lock lock(sem_recorder);
+
+          if (recorder)
+          {
+            recorder->record(f, t, inv, scale, offset, left, disp, tgrabbed);
+          }
+        }
+
+        tsync=gutil::ProcTime::monotonic();
+        addTiming(TIMING_HANDOFF, tsync-thandoff);
+
+        last_grabbed=tsync;
+      };
 
       while (running && (timeout == 0 || last_grabbed+timeout > gutil::ProcTime::monotonic()))
       {
         // grab next image with timeout
 
+        double tgrab=gutil::ProcTime::monotonic();
+
         const rcg::Buffer *buffer=stream[0]->grab(500);
         if (buffer != 0)
         {
-          // ensure heartbeat for GEV devices
-
-          if (heartbeat_timeout > 0 && last_heartbeat+heartbeat_timeout < gutil::ProcTime::monotonic())
-          {
-            gutil::Lock lock(sem_nodemap);
-            rcg::setEnum(nodemap, "LineSelector", "Out1", true);
-            rcg::getString(nodemap, "LineSource", true, true);
-
-            last_heartbeat=gutil::ProcTime::monotonic();
-          }
+          tgrabbed=gutil::ProcTime::monotonic();
+          addTiming(TIMING_GRAB_WAIT, tgrabbed-tgrab);
 
           // check for a complete image in the buffer
 
           if (!buffer->getIsIncomplete())
           {
-            gutil::Lock lock(sem_nodemap);
+            // only chunk data of the node map is accessed by this thread
+
+            tsync=gutil::ProcTime::monotonic();
 
-            // go through all parts in case of multi-part buffer
+            // pair intensity and disparity images of the same frame, either
+            // directly from a multipart buffer or by matching timestamps
 
-            size_t partn=buffer->getNumberOfParts();
-            for (uint32_t part=0; part<partn; part++)
+            GrabbedBuffer parts(*this, buffer);
+            const std::vector<FrameMatcher::Pair> &pair=matcher.add(parts, tol);
+
+            for (size_t i=0; i<pair.size(); i++)
             {
-              if (buffer->getImagePresent(part))
-              {
-                // get current out1 mode from chunk data (allowed to fail to support
-                // rc_visard / rc_cube < 22.07.0)
-
-                uint64_t ltol=tol;
-
-                rcg::setEnum(nodemap, "ChunkLineSelector", "Out1", false);
-                std::string out1_mode=rcg::getEnum(nodemap, "ChunkLineSource", false);
-
-                if (out1_mode.size() > 0)
-                {
-                  if (out1_mode == "ExposureAlternateActive")
-                  {
-                    ltol=250*1000*1000; // set maximum tolerance to 250 ms
-                  }
-                  else
-                  {
-                    ltol=0;
-                  }
-                }
-
-                // store image in the corresponding list
-
-                uint64_t left_tol=0;
-                uint64_t disp_tol=0;
-
-                std::string component=rcg::getComponetOfPart(nodemap, buffer, part);
-
-                if (component == "Intensity")
-                {
-                  left_list.add(buffer, part);
-                  disp_tol=ltol;
-                }
-                else if (component == "Disparity")
-                {
-                  disp_list.add(buffer, part);
-                  left_tol=ltol;
-                }
-
-                // get corresponding left and disparity images
-
-                uint64_t timestamp=buffer->getTimestampNS();
-                std::shared_ptr<const rcg::Image> left=left_list.find(timestamp, left_tol);
-                std::shared_ptr<const rcg::Image> disp=disp_list.find(timestamp, disp_tol);
-
-                if (left && disp)
-                {
-                  // hand the data over to the modeler
-
-                  modeler->process(f, t, inv, scale, offset, left, disp);
-
-                  // remove all images from the buffer with the current or an
-                  // older time stamp
-
-                  left_list.removeOld(timestamp);
-                  disp_list.removeOld(timestamp);
-
-                  last_grabbed=gutil::ProcTime::monotonic();
-                }
-              }
+              handOver(pair[i].left, pair[i].disp);
             }
           }
           else
@@ -531,12 +883,14 @@ void Receiver::run()
         }
         else
         {
-          gutil::Lock lock(sem_nodemap);
+          // let the control thread check if connection is still there
 
-          // check if connection is still there
+          {
+            std::lock_guard<std::mutex> lock(control_mutex);
+            check_connection=true;
+          }
 
-          rcg::setEnum(nodemap, "LineSelector", "Out1", true);
-          rcg::getString(nodemap, "LineSource", true, true);
+          control_cv.notify_one();
         }
       }
 
@@ -36,6 +36,7 @@
 #ifndef RC_GENICAM_VIEWER_RECEIVER
 #define RC_GENICAM_VIEWER_RECEIVER
 
+#include "source.h"
 #include "modeler.h"
 
 #include <rc_genicam_api/device.h>
@@ -45,6 +46,12 @@
 #include <gutil/semaphore.h>
 #include <atomic>
 #include <memory>
+#include <map>
+#include <deque>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
 
 namespace rcgv
 {
@@ -54,77 +61,55 @@ namespace rcgv
   the device in a background thread and hands them over to the modeler.
 */
 
-class Receiver: public gutil::ThreadFunction
+class Receiver: public Source, public gutil::ThreadFunction
 {
   public:
 
-    Receiver(std::shared_ptr<Modeler> modeler, const char *device,
-      double timeout, const std::vector<std::string> &genicam_param);
-    ~Receiver();
-
     /**
-      Returns true if the background thread is running.
+      Opens the device and starts grabbing.
+
+      @param modeler       Modeler that gets all synchronized images.
+      @param device        ID of device or 0 for choosing interactively.
+      @param timeout       Timeout in seconds until giving up. 0 for infinity.
+      @param genicam_param Parameters as <key>=<value> or commands as <key>.
+      @param multipart     Try SynchronizedComponents mode, in which intensity
+                           and disparity images of the same frame are
+                           delivered in one buffer, so that timestamps need
+                           not be matched. Timestamps are matched as before if
+                           the device or GenTL producer does not support it.
     */
 
-    bool isRunning() { return running; }
-
-    /**
-      Close device and free all resources.
-    */
+    Receiver(std::shared_ptr<Modeler> modeler, const char *device,
+      double timeout, const std::vector<std::string> &genicam_param, bool multipart=false);
+    ~Receiver();
 
+    bool isRunning() { return running; }
     void close();
-
-    /**
-      Tests if parameter is writable.
-
-      @param writable Return value that is set to true if parameter is writable
-                      and false if it is only readable.
-      @param name     Name of parameter.
-      @return         True if parameter exists and is readable.
-    */
+    void setRecorder(const std::shared_ptr<Recorder> &recorder);
 
     bool getWritable(bool &writable, const char *name);
-
-    /**
-      Get value of boolean GenICam parameter.
-
-      @param name Name of parameter.
-      @return     Value of parameter.
-    */
-
     bool getBoolean(const char *name);
-
-    /**
-      Set value of boolean GenICam parameter.
-
-      @param name  Name of parameter.
-      @param value Value of parameter.
-    */
-
     void setBoolean(const char *name, bool value);
+    std::string getEnum(const char *name, std::vector<std::string> &list);
+    void setEnum(const char *name, const std::string &value);
 
-    /**
-      Get value of enum GenICam parameter.
-
-      @param name Name of parameter.
-      @param list List of all enums.
-      @return     Current value of parameter.
-    */
+  private:
 
-    std::string getEnum(const char *name, std::vector<std::string> &list);
+    void run();
+    void runControl();
 
     /**
-      Set value of enum GenICam parameter.
-
-      @param name  Name of parameter.
-      @param value Current value of parameter.
+      Executes the given function in the control thread and waits until it
+      is finished. Exceptions are passed to the caller.
     */
 
-    void setEnum(const char *name, const std::string &value);
+    void call(const std::function<void()> &f);
 
-  private:
+    class GrabbedBuffer;
 
-    void run();
+    void initNodeCache();
+    const std::string &getOut1Mode();
+    std::string getComponent(const rcg::Buffer *buffer, uint32_t part);
 
     std::shared_ptr<Modeler> modeler;
 
@@ -132,14 +117,54 @@ class Receiver: public gutil::ThreadFunction
     std::shared_ptr<GenApi::CNodeMapRef> nodemap;
 
     double timeout;
+    bool multipart;
     double f, t, scale, offset;
     double inv;
-    uint64_t tol;
+    std::atomic<uint64_t> tol;
 
     gutil::Thread thread;
     std::atomic_bool running;
 
-    gutil::Semaphore sem_nodemap;
+    // all accesses to the node map, except for chunk data, are done by the
+    // control thread
+
+    class Control: public gutil::ThreadFunction
+    {
+      public:
+
+        Control(Receiver &_parent) : parent(_parent) { }
+        void run() { parent.runControl(); }
+
+        Receiver &parent;
+        gutil::Thread thread;
+    };
+
+    struct Command
+    {
+      const std::function<void()> *f;
+      gutil::Semaphore *done;
+      std::exception_ptr *error;
+    };
+
+    Control control;
+    std::mutex control_mutex;
+    std::condition_variable control_cv;
+    bool control_running;
+    bool check_connection;
+    double heartbeat_interval;
+    std::deque<Command> commands;
+
+    // nodes and values that are resolved once for the hot path of the grab
+    // thread
+
+    GenApi::CEnumerationPtr chunk_line_selector;
+    GenApi::CEnumerationPtr chunk_line_source;
+    int64_t chunk_out1;
+    std::map<int64_t, std::string> chunk_line_source_name;
+    std::map<uint64_t, std::string> component_name;
+
+    gutil::Semaphore sem_recorder;
+    std::shared_ptr<Recorder> recorder;
 };
 
 }
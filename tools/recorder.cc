@@ -0,0 +1,382 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "recorder.h"
+#include "recording.h"
+
+#include <gutil/proctime.h>
+#include <gutil/exception.h>
+
+#include <cstring>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+namespace rcgv
+{
+
+namespace
+{
+
+/*
+  Frames are written in batches of this size, which is a multiple of the
+  page size of all common file systems. All writes, except the last one,
+  have this size and therefore start at aligned file positions.
+*/
+
+const size_t BATCH_SIZE=8*1024*1024;
+const size_t BATCH_ALIGN=4096;
+
+/*
+  Maximum number of frames in the backlog, independent of their size.
+*/
+
+const int MAX_FRAMES=256;
+
+inline uint64_t alignSize(uint64_t n)
+{
+  return (n+RECORDING_ALIGN-1)&~(RECORDING_ALIGN-1);
+}
+
+inline size_t getImageSize(const RawImage &image)
+{
+  return (RawImage::getLineSize(image.getWidth(), image.getPixelFormat())+
+    image.getXPadding())*image.getHeight();
+}
+
+void setImage(RecordingImage &ri, const RawImage &image, uint64_t offset)
+{
+  ri.offset=offset;
+  ri.size=getImageSize(image);
+  ri.timestamp=image.getTimestampNS();
+  ri.format=image.getPixelFormat();
+  ri.width=static_cast<uint32_t>(image.getWidth());
+  ri.height=static_cast<uint32_t>(image.getHeight());
+  ri.xpadding=static_cast<uint32_t>(image.getXPadding());
+  ri.bigendian=image.isBigEndian() ? 1 : 0;
+}
+
+}
+
+Recorder::Recorder(const std::string &_name, size_t _maxbacklog) :
+  msg_pool(8), sem(1), queue(MAX_FRAMES+1), batch_mem(BATCH_SIZE+BATCH_ALIGN)
+{
+  name=_name;
+  maxbacklog=_maxbacklog;
+  backlog=0;
+  stopped=false;
+
+  frames=0;
+  dropped=0;
+  written=0;
+  error=false;
+  finished=false;
+
+  // the batch buffer is aligned for the benefit of the operating system
+
+  batch=batch_mem.data()+(BATCH_ALIGN-reinterpret_cast<uintptr_t>(batch_mem.data())%BATCH_ALIGN)%
+    BATCH_ALIGN;
+  fill=0;
+  fpos=0;
+
+  index.reserve(4096);
+
+  file=fopen(name.c_str(), "wb");
+
+  if (file == 0)
+  {
+    throw gutil::IOException("Cannot create recording: "+name);
+  }
+
+  // data is already collected in large batches
+
+  setvbuf(file, 0, _IONBF, 0);
+
+  // write header
+
+  RecordingHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, "RCGVREC1", 8);
+  header.version=RECORDING_VERSION;
+  header.byteorder=RECORDING_BYTEORDER;
+  header.size=sizeof(header);
+
+  append(&header, sizeof(header));
+
+  tlast=gutil::ProcTime::monotonic();
+  wlast=0;
+
+  thread.create(*this);
+}
+
+Recorder::~Recorder()
+{
+  stop();
+  thread.join();
+}
+
+bool Recorder::record(double f, double t, double inv, double scale, double offset,
+                      const std::shared_ptr<const RawImage> &left,
+                      const std::shared_ptr<const RawImage> &disp, double grabbed)
+{
+  gutil::Lock lock(sem);
+
+  if (stopped)
+  {
+    return false;
+  }
+
+  size_t bytes=getImageSize(*left)+getImageSize(*disp);
+
+  // never block the caller if writing does not keep up
+
+  if (error || queue.size() >= MAX_FRAMES || backlog+bytes > maxbacklog)
+  {
+    dropped++;
+    return false;
+  }
+
+  std::shared_ptr<FrameMsg> msg=msg_pool.get();
+
+  msg->f=f;
+  msg->t=t;
+  msg->inv=inv;
+  msg->scale=scale;
+  msg->offset=offset;
+  msg->grabbed=grabbed;
+  msg->bytes=bytes;
+  msg->left=left;
+  msg->disp=disp;
+
+  backlog+=bytes;
+  queue.push(msg);
+
+  return true;
+}
+
+void Recorder::stop()
+{
+  gutil::Lock lock(sem);
+
+  if (!stopped)
+  {
+    // the queue has space for one more element than record() uses, so that
+    // this does not block
+
+    stopped=true;
+    queue.push(std::shared_ptr<FrameMsg>());
+  }
+}
+
+std::string Recorder::getStatusLine()
+{
+  std::ostringstream out;
+
+  double tcurr=gutil::ProcTime::monotonic();
+  uint64_t w=written;
+
+  out << "Recording " << frames << " frames";
+
+  if (error)
+  {
+    out << ", write error";
+  }
+  else
+  {
+    out << ", " << std::fixed << std::setprecision(1) <<
+      (w-wlast)/(1024.0*1024.0)/std::max(0.001, tcurr-tlast) << " MB/s";
+  }
+
+  out << ", backlog " << queue.size() << " frames / " << std::fixed << std::setprecision(1) <<
+    backlog/(1024.0*1024.0) << " MB, dropped " << dropped;
+
+  tlast=tcurr;
+  wlast=w;
+
+  return out.str();
+}
+
+void Recorder::run()
+{
+  while (true)
+  {
+    std::shared_ptr<FrameMsg> msg=queue.pop();
+
+    if (!msg)
+    {
+      break;
+    }
+
+    if (!error)
+    {
+      writeFrame(*msg);
+    }
+
+    if (!error)
+    {
+      frames++;
+    }
+    else
+    {
+      dropped++;
+    }
+
+    // release images before reducing the backlog
+
+    size_t bytes=msg->bytes;
+    msg->left.reset();
+    msg->disp.reset();
+    msg.reset();
+
+    backlog-=bytes;
+  }
+
+  if (!error)
+  {
+    // append index and trailer
+
+    uint64_t ipos=fpos+fill;
+
+    for (size_t i=0; i<index.size(); i++)
+    {
+      RecordingIndex ri;
+      memset(&ri, 0, sizeof(ri));
+      ri.offset=index[i].offset;
+      ri.timestamp=index[i].timestamp;
+      ri.grabbed=index[i].grabbed;
+
+      append(&ri, sizeof(ri));
+    }
+
+    RecordingTrailer trailer;
+    memset(&trailer, 0, sizeof(trailer));
+    memcpy(trailer.magic, "RCGVIDX1", 8);
+    trailer.count=index.size();
+    trailer.offset=ipos;
+
+    append(&trailer, sizeof(trailer));
+
+    flush();
+  }
+
+  if (fclose(file) != 0)
+  {
+    error=true;
+  }
+
+  finished=true;
+}
+
+void Recorder::writeFrame(const FrameMsg &msg)
+{
+  const RawImage &left=*msg.left;
+  const RawImage &disp=*msg.disp;
+
+  RecordingFrame frame;
+  memset(&frame, 0, sizeof(frame));
+  memcpy(frame.magic, "FRM1", 4);
+
+  frame.f=msg.f;
+  frame.t=msg.t;
+  frame.inv=msg.inv;
+  frame.scale=msg.scale;
+  frame.offset=msg.offset;
+  frame.grabbed=msg.grabbed;
+
+  setImage(frame.left, left, sizeof(frame));
+  setImage(frame.disp, disp, frame.left.offset+alignSize(frame.left.size));
+  frame.size=frame.disp.offset+alignSize(frame.disp.size);
+
+  IndexEntry e;
+  e.offset=fpos+fill;
+  e.timestamp=frame.disp.timestamp;
+  e.grabbed=msg.grabbed;
+  index.push_back(e);
+
+  append(&frame, sizeof(frame));
+  append(left.getPixels(), frame.left.size);
+  pad();
+  append(disp.getPixels(), frame.disp.size);
+  pad();
+}
+
+void Recorder::append(const void *data, size_t n)
+{
+  const uint8_t *p=static_cast<const uint8_t *>(data);
+
+  while (n > 0 && !error)
+  {
+    size_t c=std::min(n, BATCH_SIZE-fill);
+
+    memcpy(batch+fill, p, c);
+    fill+=c;
+    p+=c;
+    n-=c;
+
+    if (fill == BATCH_SIZE)
+    {
+      flush();
+    }
+  }
+}
+
+void Recorder::pad()
+{
+  static const uint8_t zero[RECORDING_ALIGN]={0};
+
+  uint64_t n=(fpos+fill)%RECORDING_ALIGN;
+
+  if (n > 0)
+  {
+    append(zero, RECORDING_ALIGN-n);
+  }
+}
+
+void Recorder::flush()
+{
+  if (fill > 0 && !error)
+  {
+    if (fwrite(batch, 1, fill, file) != fill)
+    {
+      error=true;
+    }
+
+    fpos+=fill;
+    written+=fill;
+    fill=0;
+  }
+}
+
+}
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_RECORDER
+#define RC_GENICAM_VIEWER_RECORDER
+
+#include "boundedqueue.h"
+#include "pool.h"
+#include "rawimage.h"
+
+#include <gutil/thread.h>
+#include <gutil/semaphore.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Records synchronized intensity and disparity images with all parameters
+  that are needed for creating models into a file. The format is described
+  in recording.h.
+
+  Frames are only queued by record() and written by a dedicated background
+  thread in large batches, so that recording never blocks the caller. If
+  writing cannot keep up and the backlog exceeds its limit, frames are
+  dropped from the recording, but not from the live view.
+*/
+
+class Recorder: public gutil::ThreadFunction
+{
+  public:
+
+    /**
+      Creates the file and starts the background thread. An IOException is
+      thrown if the file cannot be created.
+
+      @param name       Name of file.
+      @param maxbacklog Maximum number of bytes that are kept in memory while
+                        waiting for being written.
+    */
+
+    Recorder(const std::string &name, size_t maxbacklog=512*1024*1024);
+
+    /**
+      Writes all pending frames and closes the file.
+    */
+
+    ~Recorder();
+
+    /**
+      Queues the given data for recording. This call does not block.
+
+      @return False if the frame has been dropped, because the backlog is
+              full, writing failed or the recorder is stopped.
+    */
+
+    bool record(double f, double t, double inv, double scale, double offset,
+                const std::shared_ptr<const RawImage> &left,
+                const std::shared_ptr<const RawImage> &disp, double grabbed);
+
+    /**
+      Stops accepting frames. Pending frames are written and the file is
+      closed in the background. This call does not block.
+    */
+
+    void stop();
+
+    /**
+      Returns true if the file has been closed after stop().
+    */
+
+    bool isFinished() { return finished; }
+
+    const std::string &getName() { return name; }
+
+    /**
+      Returns a line with the number of recorded and dropped frames, the
+      write throughput since the last call and the current backlog, or an
+      error message if writing failed.
+    */
+
+    std::string getStatusLine();
+
+    void run();
+
+  private:
+
+    Recorder(const Recorder &);
+    Recorder &operator=(const Recorder &);
+
+    struct FrameMsg
+    {
+      double f;
+      double t;
+      double inv;
+      double scale;
+      double offset;
+      double grabbed;
+      size_t bytes;
+      std::shared_ptr<const RawImage> left;
+      std::shared_ptr<const RawImage> disp;
+    };
+
+    void writeFrame(const FrameMsg &msg);
+    void append(const void *data, size_t n);
+    void pad();
+    void flush();
+
+    std::string name;
+    FILE *file;
+
+    size_t maxbacklog;
+    std::atomic<size_t> backlog;
+
+    Pool<FrameMsg> msg_pool;
+    gutil::Semaphore sem;
+    BoundedQueue<std::shared_ptr<FrameMsg> > queue;
+    bool stopped;
+
+    std::vector<uint8_t> batch_mem;
+    uint8_t *batch;
+    size_t fill;
+    uint64_t fpos;
+
+    struct IndexEntry
+    {
+      uint64_t offset;
+      uint64_t timestamp;
+      double grabbed;
+    };
+
+    std::vector<IndexEntry> index;
+
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> written;
+    std::atomic_bool error;
+    std::atomic_bool finished;
+
+    double tlast;
+    uint64_t wlast;
+
+    gutil::Thread thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_RECORDING
+#define RC_GENICAM_VIEWER_RECORDING
+
+#include <cstdint>
+
+namespace rcgv
+{
+
+/**
+  Layout of recordings of synchronized intensity and disparity images.
+
+  A recording starts with a RecordingHeader, followed by one record per frame.
+  Each record consists of a RecordingFrame, the raw pixels of the left image
+  and the raw pixels of the disparity image, exactly as they have been
+  delivered by the device, including row padding. All parts of a record start
+  at multiples of RECORDING_ALIGN bytes, so that a memory mapped recording
+  can be used without copying.
+
+  After the last record, a list of RecordingIndex entries and a
+  RecordingTrailer are appended when the recording is closed. If the trailer
+  is missing, e.g. after a crash, the index can be recovered by following the
+  size fields of the records.
+
+  All values are stored in the byte order of the recording host, which is
+  identified by the byteorder field of the header.
+*/
+
+const uint32_t RECORDING_VERSION=1;
+const uint64_t RECORDING_ALIGN=64;
+const uint32_t RECORDING_BYTEORDER=0x01020304;
+
+struct RecordingHeader
+{
+  char magic[8];       // "RCGVREC1"
+  uint32_t version;    // RECORDING_VERSION
+  uint32_t byteorder;  // RECORDING_BYTEORDER in host byte order
+  uint64_t size;       // size of the header in bytes
+  uint64_t reserved[5];
+};
+
+struct RecordingImage
+{
+  uint64_t offset;     // offset of pixels relative to the frame record
+  uint64_t size;       // number of bytes of pixels, including row padding
+  uint64_t timestamp;  // timestamp of the device in ns
+  uint64_t format;     // pixel format of the device
+  uint32_t width;
+  uint32_t height;
+  uint32_t xpadding;   // number of padding bytes at the end of each row
+  uint32_t bigendian;  // 1 if 16 bit values are stored in big endian
+};
+
+struct RecordingFrame
+{
+  char magic[4];       // "FRM1"
+  uint32_t reserved0;
+  uint64_t size;       // size of the record including pixels and padding
+  double f;            // focal length factor
+  double t;            // baseline in m
+  double inv;          // invalid disparity value
+  double scale;        // disparity scale
+  double offset;       // disparity offset
+  double grabbed;      // monotonic host time of grabbing in s
+  RecordingImage left;
+  RecordingImage disp;
+  uint64_t reserved1[4];
+};
+
+struct RecordingIndex
+{
+  uint64_t offset;     // offset of the frame record in the file
+  uint64_t timestamp;  // timestamp of the disparity image in ns
+  double grabbed;      // monotonic host time of grabbing in s
+  uint64_t reserved;
+};
+
+struct RecordingTrailer
+{
+  char magic[8];       // "RCGVIDX1"
+  uint64_t count;      // number of frames
+  uint64_t offset;     // offset of the first RecordingIndex in the file
+  uint64_t reserved;
+};
+
+static_assert(sizeof(RecordingHeader)%RECORDING_ALIGN == 0, "Header must be aligned");
+static_assert(sizeof(RecordingFrame)%RECORDING_ALIGN == 0, "Frame must be aligned");
+static_assert(sizeof(RecordingIndex) == 32, "Unexpected size of index");
+static_assert(sizeof(RecordingTrailer) == 32, "Unexpected size of trailer");
+
+}
+
+#endif
@@ -0,0 +1,329 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "replay.h"
+#include "recording.h"
+#include "timing.h"
+#include "framestats.h"
+
+#include <rc_genicam_api/pixel_formats.h>
+
+#include <gutil/proctime.h>
+#include <gutil/exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+namespace rcgv
+{
+
+Replay::Replay(std::shared_ptr<Modeler> _modeler, const std::string &name, double _rate,
+               int _repeat)
+{
+  sem_recorder.increment();
+
+  modeler=_modeler;
+  rate=_rate;
+  repeat=_repeat;
+
+  file=std::make_shared<MappedFile>(name);
+
+  // check header
+
+  const RecordingHeader *header=reinterpret_cast<const RecordingHeader *>(file->getData());
+
+  if (file->getSize() < sizeof(RecordingHeader) || memcmp(header->magic, "RCGVREC1", 8) != 0 ||
+      header->size < sizeof(RecordingHeader) || header->size%RECORDING_ALIGN != 0)
+  {
+    throw gutil::IOException("Not a recording: "+name);
+  }
+
+  if (header->byteorder != RECORDING_BYTEORDER)
+  {
+    throw gutil::IOException("Recording has been created on a host with different byte order: "+
+      name);
+  }
+
+  if (header->version != RECORDING_VERSION)
+  {
+    throw gutil::IOException("Unsupported version of recording: "+name);
+  }
+
+  // get frames from the index, if the recording has been closed properly
+
+  uint64_t size=file->getSize();
+  const RecordingTrailer *trailer=0;
+
+  if (size >= header->size+sizeof(RecordingTrailer))
+  {
+    trailer=reinterpret_cast<const RecordingTrailer *>(file->getData()+size-
+      sizeof(RecordingTrailer));
+
+    if (memcmp(trailer->magic, "RCGVIDX1", 8) != 0 || trailer->offset < header->size ||
+        trailer->count >= size/sizeof(RecordingIndex) ||
+        trailer->offset%sizeof(RecordingIndex) != 0 ||
+        trailer->offset+(trailer->count+1)*sizeof(RecordingIndex) != size)
+    {
+      trailer=0;
+    }
+  }
+
+  if (trailer)
+  {
+    const RecordingIndex *index=reinterpret_cast<const RecordingIndex *>(file->getData()+
+      trailer->offset);
+
+    frame.resize(trailer->count);
+
+    for (size_t i=0; i<frame.size(); i++)
+    {
+      frame[i].frame=getFrame(index[i].offset);
+
+      if (frame[i].frame == 0)
+      {
+        throw gutil::IOException("Recording is damaged: "+name);
+      }
+    }
+  }
+  else
+  {
+    // otherwise recover the frames by following the records, e.g. if
+    // recording has been interrupted
+
+    uint64_t pos=header->size;
+    const RecordingFrame *p=getFrame(pos);
+
+    while (p != 0)
+    {
+      FrameRef ref;
+      ref.frame=p;
+      frame.push_back(ref);
+
+      pos+=p->size;
+      p=getFrame(pos);
+    }
+  }
+
+  if (frame.size() == 0)
+  {
+    throw gutil::IOException("Recording does not contain any frames: "+name);
+  }
+
+  // the time of the device is used for replaying with the recorded timing
+
+  for (size_t i=0; i<frame.size(); i++)
+  {
+    frame[i].timestamp=frame[i].frame->disp.timestamp/1000000000.0;
+  }
+
+  // start background thread for replaying images
+
+  running=true;
+  joinable=true;
+  thread.create(*this);
+}
+
+Replay::~Replay()
+{
+  close();
+}
+
+void Replay::close()
+{
+  running=false;
+
+  if (joinable)
+  {
+    thread.join();
+    joinable=false;
+  }
+
+  modeler.reset();
+  setRecorder(std::shared_ptr<Recorder>());
+}
+
+void Replay::setRecorder(const std::shared_ptr<Recorder> &_recorder)
+{
+  gutil::Lock lock(sem_recorder);
+  recorder=_recorder;
+}
+
+std::string Replay::getEnum(const char *name, std::vector<std::string> &list)
+{
+  list.clear();
+  return std::string();
+}
+
+const RecordingFrame *Replay::getFrame(uint64_t offset)
+{
+  // all sizes and offsets are checked, so that damaged recordings cannot
+  // lead to access outside of the file
+
+  uint64_t size=file->getSize();
+
+  if (offset%RECORDING_ALIGN != 0 || offset >= size || size-offset < sizeof(RecordingFrame))
+  {
+    return 0;
+  }
+
+  const RecordingFrame *ret=reinterpret_cast<const RecordingFrame *>(file->getData()+offset);
+
+  if (memcmp(ret->magic, "FRM1", 4) != 0 || ret->size < sizeof(RecordingFrame) ||
+      ret->size%RECORDING_ALIGN != 0 || ret->size > size-offset)
+  {
+    return 0;
+  }
+
+  // the modeler reads 16 bit per disparity, regardless of the format
+
+  if (ret->disp.format != Coord3D_C16 && ret->disp.format != Mono16)
+  {
+    return 0;
+  }
+
+  const RecordingImage *image[]={&ret->left, &ret->disp};
+
+  for (int i=0; i<2; i++)
+  {
+    uint64_t line=RawImage::getLineSize(image[i]->width, image[i]->format);
+
+    if (line == 0 || image[i]->size < (line+image[i]->xpadding)*image[i]->height ||
+        image[i]->offset%RECORDING_ALIGN != 0 || image[i]->offset > ret->size ||
+        image[i]->size > ret->size-image[i]->offset)
+    {
+      return 0;
+    }
+  }
+
+  return ret;
+}
+
+bool Replay::waitUntil(double t)
+{
+  double now=gutil::ProcTime::monotonic();
+
+  while (running && now < t)
+  {
+    double d=std::min(0.05, t-now);
+    std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(1000000*d)));
+
+    now=gutil::ProcTime::monotonic();
+  }
+
+  return running;
+}
+
+void Replay::run()
+{
+  double tstart=gutil::ProcTime::monotonic();
+  double tloop=tstart;
+  uint64_t count=0;
+
+  // average time between recorded frames, for continuing after the last
+  // frame when repeating
+
+  double period=0;
+  if (frame.size() > 1)
+  {
+    period=std::max(0.0, (frame.back().timestamp-frame[0].timestamp)/(frame.size()-1));
+  }
+
+  for (int loop=0; running && (repeat == 0 || loop < repeat); loop++)
+  {
+    for (size_t i=0; i<frame.size() && running; i++)
+    {
+      // wait until the frame is due
+
+      if (rate > 0)
+      {
+        waitUntil(tstart+count/rate);
+      }
+      else if (rate == 0)
+      {
+        waitUntil(tloop+frame[i].timestamp-frame[0].timestamp);
+      }
+
+      if (!running)
+      {
+        break;
+      }
+
+      // refer to the pixels of the mapped file
+
+      const RecordingFrame &fr=*frame[i].frame;
+      const uint8_t *p=reinterpret_cast<const uint8_t *>(&fr);
+
+      std::shared_ptr<RawImage> left=std::make_shared<RawImage>(file, p+fr.left.offset,
+        fr.left.width, fr.left.height, fr.left.format, fr.left.bigendian != 0,
+        fr.left.xpadding);
+      left->setTimestampNS(fr.left.timestamp);
+
+      std::shared_ptr<RawImage> disp=std::make_shared<RawImage>(file, p+fr.disp.offset,
+        fr.disp.width, fr.disp.height, fr.disp.format, fr.disp.bigendian != 0,
+        fr.disp.xpadding);
+      disp->setTimestampNS(fr.disp.timestamp);
+
+      incCounter(COUNT_IMAGES);
+      incCounter(COUNT_IMAGES);
+
+      // hand the data over to the modeler
+
+      double thandoff=gutil::ProcTime::monotonic();
+
+      modeler->process(fr.f, fr.t, fr.inv, fr.scale, fr.offset, left, disp, thandoff);
+
+      {
+        gutil::Lock lock(sem_recorder);
+
+        if (recorder)
+        {
+          recorder->record(fr.f, fr.t, fr.inv, fr.scale, fr.offset, left, disp, thandoff);
+        }
+      }
+
+      addTiming(TIMING_HANDOFF, gutil::ProcTime::monotonic()-thandoff);
+
+      count++;
+    }
+
+    tloop+=frame.back().timestamp-frame[0].timestamp+period;
+  }
+
+  running=false;
+}
+
+}
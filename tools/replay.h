@@ -0,0 +1,131 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_REPLAY
+#define RC_GENICAM_VIEWER_REPLAY
+
+#include "source.h"
+#include "modeler.h"
+#include "mappedfile.h"
+
+#include <gutil/thread.h>
+#include <gutil/semaphore.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+struct RecordingFrame;
+
+/**
+  Replay object that memory maps a recording (see recording.h) and hands the
+  recorded images over to the modeler in a background thread, without
+  copying the pixels. Device parameters are not available.
+*/
+
+class Replay: public Source, public gutil::ThreadFunction
+{
+  public:
+
+    /**
+      Opens the recording and starts the background thread. An IOException
+      is thrown if the file cannot be opened or is not a valid recording.
+
+      @param modeler Modeler that gets the images.
+      @param name    Name of recording.
+      @param rate    0 for replaying with the recorded timing, a positive
+                     value for replaying with a fixed rate in Hz and a
+                     negative value for replaying as fast as possible.
+      @param repeat  Number of times that the recording is replayed. 0 for
+                     replaying until closed.
+    */
+
+    Replay(std::shared_ptr<Modeler> modeler, const std::string &name, double rate=0,
+           int repeat=1);
+    ~Replay();
+
+    /**
+      Returns the number of frames of the recording.
+    */
+
+    size_t getFrameCount() { return frame.size(); }
+
+    bool isRunning() { return running; }
+    void close();
+    void setRecorder(const std::shared_ptr<Recorder> &recorder);
+
+    bool getWritable(bool &writable, const char *name) { return false; }
+    bool getBoolean(const char *name) { return false; }
+    void setBoolean(const char *name, bool value) { }
+    std::string getEnum(const char *name, std::vector<std::string> &list);
+    void setEnum(const char *name, const std::string &value) { }
+
+  private:
+
+    void run();
+
+    const RecordingFrame *getFrame(uint64_t offset);
+    bool waitUntil(double t);
+
+    std::shared_ptr<Modeler> modeler;
+    std::shared_ptr<MappedFile> file;
+
+    struct FrameRef
+    {
+      const RecordingFrame *frame;
+      double timestamp;
+    };
+
+    std::vector<FrameRef> frame;
+
+    double rate;
+    int repeat;
+
+    gutil::Thread thread;
+    bool joinable;
+    std::atomic_bool running;
+
+    gutil::Semaphore sem_recorder;
+    std::shared_ptr<Recorder> recorder;
+};
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sharedmemory.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rcgv
+{
+
+SharedMemory::SharedMemory()
+{
+  owner=false;
+  data=0;
+  size=0;
+
+#ifdef WIN32
+  mapping=0;
+#else
+  dev=0;
+  ino=0;
+#endif
+}
+
+SharedMemory::~SharedMemory()
+{
+  close();
+}
+
+#ifdef WIN32
+
+bool SharedMemory::create(const std::string &_name, uint64_t _size)
+{
+  close();
+
+  // the segment exists as long as any process has a handle to it, in which
+  // case it is taken over if it is large enough
+
+  std::string n="Local\\"+_name;
+  mapping=CreateFileMappingA(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE,
+    static_cast<DWORD>(_size>>32), static_cast<DWORD>(_size&0xffffffff), n.c_str());
+
+  if (mapping != 0)
+  {
+    data=static_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0));
+  }
+
+  MEMORY_BASIC_INFORMATION info;
+
+  if (data == 0 || VirtualQuery(data, &info, sizeof(info)) == 0 ||
+      static_cast<uint64_t>(info.RegionSize) < _size)
+  {
+    close();
+    return false;
+  }
+
+  name=_name;
+  owner=true;
+  size=_size;
+
+  return true;
+}
+
+bool SharedMemory::open(const std::string &_name)
+{
+  close();
+
+  std::string n="Local\\"+_name;
+  mapping=OpenFileMappingA(FILE_MAP_READ, FALSE, n.c_str());
+
+  if (mapping != 0)
+  {
+    data=static_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  }
+
+  MEMORY_BASIC_INFORMATION info;
+
+  if (data == 0 || VirtualQuery(data, &info, sizeof(info)) == 0)
+  {
+    close();
+    return false;
+  }
+
+  name=_name;
+  size=static_cast<uint64_t>(info.RegionSize);
+
+  return true;
+}
+
+bool SharedMemory::isCurrent() const
+{
+  // an existing segment is always taken over by create()
+
+  return data != 0;
+}
+
+void SharedMemory::close()
+{
+  if (data != 0) UnmapViewOfFile(data);
+  if (mapping != 0) CloseHandle(mapping);
+
+  owner=false;
+  data=0;
+  size=0;
+  mapping=0;
+}
+
+#else
+
+bool SharedMemory::create(const std::string &_name, uint64_t _size)
+{
+  close();
+
+  std::string n="/"+_name;
+  shm_unlink(n.c_str());
+
+  int fd=shm_open(n.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  // the memory of the segment is only allocated when it is used
+
+  void *p=MAP_FAILED;
+
+  if (ftruncate(fd, static_cast<off_t>(_size)) == 0)
+  {
+    p=mmap(0, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+
+  if (p == MAP_FAILED)
+  {
+    ::close(fd);
+    shm_unlink(n.c_str());
+    return false;
+  }
+
+  name=_name;
+  owner=true;
+  data=static_cast<uint8_t *>(p);
+  size=_size;
+
+  struct stat st;
+
+  if (fstat(fd, &st) == 0)
+  {
+    dev=static_cast<uint64_t>(st.st_dev);
+    ino=static_cast<uint64_t>(st.st_ino);
+  }
+
+  ::close(fd);
+
+  return true;
+}
+
+bool SharedMemory::open(const std::string &_name)
+{
+  close();
+
+  std::string n="/"+_name;
+  int fd=shm_open(n.c_str(), O_RDONLY, 0);
+
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat st;
+  void *p=MAP_FAILED;
+
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    p=mmap(0, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  }
+
+  ::close(fd);
+
+  if (p == MAP_FAILED)
+  {
+    return false;
+  }
+
+  name=_name;
+  data=static_cast<uint8_t *>(p);
+  size=static_cast<uint64_t>(st.st_size);
+  dev=static_cast<uint64_t>(st.st_dev);
+  ino=static_cast<uint64_t>(st.st_ino);
+
+  return true;
+}
+
+bool SharedMemory::isCurrent() const
+{
+  if (data == 0)
+  {
+    return false;
+  }
+
+  // compare the object that the name refers to with the mapped one
+
+  int fd=shm_open(("/"+name).c_str(), O_RDONLY, 0);
+
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat st;
+  bool ret=(fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_dev) == dev &&
+    static_cast<uint64_t>(st.st_ino) == ino);
+
+  ::close(fd);
+
+  return ret;
+}
+
+void SharedMemory::close()
+{
+  if (data != 0)
+  {
+    munmap(data, size);
+
+    if (owner)
+    {
+      shm_unlink(("/"+name).c_str());
+    }
+  }
+
+  owner=false;
+  data=0;
+  size=0;
+  dev=0;
+  ino=0;
+}
+
+#endif
+
+}
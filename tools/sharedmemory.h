@@ -0,0 +1,119 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SHAREDMEMORY
+#define RC_GENICAM_VIEWER_SHAREDMEMORY
+
+#include <cstdint>
+#include <string>
+
+namespace rcgv
+{
+
+/**
+  Named shared memory segment. This does not throw exceptions, since it is
+  also used by the reader library.
+*/
+
+class SharedMemory
+{
+  public:
+
+    SharedMemory();
+    ~SharedMemory();
+
+    /**
+      Creates a new segment for reading and writing. A segment with the same
+      name, e.g. from a crashed process, is replaced. Processes that still
+      have the old segment open keep it until they open it again.
+
+      On Windows, a segment cannot be removed while other processes have
+      opened it. In this case, the existing segment is taken over if it is
+      large enough and its content is kept.
+
+      @param name Name of segment without leading slash.
+      @param size Size in bytes.
+      @return     False if the segment cannot be created.
+    */
+
+    bool create(const std::string &name, uint64_t size);
+
+    /**
+      Opens an existing segment for reading.
+
+      @param name Name of segment without leading slash.
+      @return     False if the segment does not exist or cannot be mapped.
+    */
+
+    bool open(const std::string &name);
+
+    /**
+      Returns true if the name still refers to the opened segment. This is
+      not the case if the segment has been replaced by create() in another
+      process, e.g. after the creating process crashed.
+    */
+
+    bool isCurrent() const;
+
+    /**
+      Unmaps the segment. A created segment is removed, but stays valid for
+      all processes that have opened it.
+    */
+
+    void close();
+
+    uint8_t *getData() const { return data; }
+    uint64_t getSize() const { return size; }
+
+  private:
+
+    SharedMemory(const SharedMemory &);
+    SharedMemory &operator=(const SharedMemory &);
+
+    std::string name;
+    bool owner;
+    uint8_t *data;
+    uint64_t size;
+
+#ifdef WIN32
+    void *mapping;
+#else
+    uint64_t dev, ino;
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SHMMESH
+#define RC_GENICAM_VIEWER_SHMMESH
+
+#include <atomic>
+#include <cstdint>
+
+namespace rcgv
+{
+
+/**
+  Layout of the shared memory segment in which the latest meshes are
+  published for other processes on the same host.
+
+  The segment starts with a ShmHeader, followed by nslots slots of slot_size
+  bytes each. Frames are numbered from 1 and frame n is stored in slot
+  (n-1)%nslots. Each slot starts with a ShmFrame, followed by the vertices as
+  x, y, z floats in camera coordinates in m, the colors as r, g, b bytes and
+  the triangles as three uint32 vertex indices each. All arrays start at
+  multiples of SHM_ALIGN bytes relative to the slot.
+
+  There is one writer and any number of readers, which never block each
+  other. The writer sets the number of the frame in the slot to 0 before
+  changing the slot and to the frame number after all data has been written.
+  Then, latest of the header is set to the frame number. A reader takes the
+  slot of latest, checks that its number is equal to latest, uses the data
+  and checks again that the number is unchanged. Otherwise, the data has
+  been overwritten in the meantime. A reader has about nslots-1 frame
+  periods for using the data of a frame without copying.
+
+  All values are stored in the byte order of the host, which is identified
+  by the byteorder field of the header. The header state is set to
+  SHM_CLOSED if the publisher stops, so that readers can open the segment
+  again if the publisher is restarted. A crashed publisher leaves the state
+  unchanged, so that readers check if the name still refers to their segment
+  if no new frame arrived for a while. A restarted publisher sets the state
+  to 0 while it initializes the header, since it may take over the existing
+  segment, which is always the case on Windows if readers still have it
+  open.
+*/
+
+const uint32_t SHM_VERSION=1;
+const uint64_t SHM_ALIGN=64;
+const uint32_t SHM_BYTEORDER=0x01020304;
+const char * const SHM_DEFAULT_NAME="rcgv_mesh";
+
+enum ShmState { SHM_ACTIVE=1, SHM_CLOSED=2 };
+
+struct ShmHeader
+{
+  char magic[8];                 // "RCGVSHM1"
+  uint32_t version;              // SHM_VERSION
+  uint32_t byteorder;            // SHM_BYTEORDER in host byte order
+  uint32_t nslots;               // number of slots
+  std::atomic<uint32_t> state;   // SHM_ACTIVE or SHM_CLOSED
+  uint64_t slot_size;            // size of each slot in bytes
+  uint64_t max_vertices;         // maximum number of vertices per frame
+  uint64_t max_triangles;        // maximum number of triangles per frame
+  std::atomic<uint64_t> latest;  // number of the latest complete frame or 0
+  uint64_t reserved;
+};
+
+struct ShmFrame
+{
+  std::atomic<uint64_t> number;  // frame number, 0 while the slot is written
+  uint64_t timestamp;            // timestamp of the disparity image in ns
+  double grabbed;                // monotonic host time of grabbing in s
+  double published;              // monotonic host time of publishing in s
+  uint32_t vertex_count;
+  uint32_t triangle_count;
+  uint64_t vertex_offset;        // offset of vertices relative to the slot
+  uint64_t color_offset;         // offset of colors relative to the slot
+  uint64_t index_offset;         // offset of triangles relative to the slot
+  uint64_t reserved[8];
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == 8, "Unexpected size of atomic");
+static_assert(sizeof(ShmHeader) == SHM_ALIGN, "Header must be aligned");
+static_assert(sizeof(ShmFrame)%SHM_ALIGN == 0, "Frame must be aligned");
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shmpublisher.h"
+
+#include <gutil/proctime.h>
+#include <gutil/exception.h>
+
+#include <iostream>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+
+namespace rcgv
+{
+
+namespace
+{
+
+uint64_t align(uint64_t size)
+{
+  return (size+SHM_ALIGN-1)/SHM_ALIGN*SHM_ALIGN;
+}
+
+}
+
+ShmPublisher::ShmPublisher(const std::string &_name, int nslots, uint64_t max_vertices) :
+  queue(1)
+{
+  name=_name;
+  count=0;
+  reported=false;
+
+  if (!std::atomic<uint64_t>().is_lock_free())
+  {
+    throw gutil::IOException("Shared memory requires lock free 64 bit atomics");
+  }
+
+  // the memory of the segment is only allocated by the system when it is
+  // written, so that the maximum size can be generous
+
+  nslots=std::max(2, nslots);
+
+  uint64_t max_triangles=2*max_vertices;
+  uint64_t slot_size=align(sizeof(ShmFrame))+align(12*max_vertices)+align(3*max_vertices)+
+    align(12*max_triangles);
+
+  if (!shm.create(name, sizeof(ShmHeader)+nslots*slot_size))
+  {
+    throw gutil::IOException("Cannot create shared memory: "+name);
+  }
+
+  // the state is set last, so that readers only use complete headers, and
+  // all slots are invalidated, since an existing segment may be taken over
+
+  header=reinterpret_cast<ShmHeader *>(shm.getData());
+  header->state.store(0, std::memory_order_release);
+
+  for (int i=0; i<nslots; i++)
+  {
+    ShmFrame *frame=reinterpret_cast<ShmFrame *>(shm.getData()+sizeof(ShmHeader)+i*slot_size);
+    frame->number.store(0, std::memory_order_relaxed);
+  }
+
+  memcpy(header->magic, "RCGVSHM1", 8);
+  header->version=SHM_VERSION;
+  header->byteorder=SHM_BYTEORDER;
+  header->nslots=static_cast<uint32_t>(nslots);
+  header->slot_size=slot_size;
+  header->max_vertices=max_vertices;
+  header->max_triangles=max_triangles;
+  header->latest.store(0, std::memory_order_relaxed);
+  header->reserved=0;
+  header->state.store(SHM_ACTIVE, std::memory_order_release);
+
+  thread.create(*this);
+}
+
+ShmPublisher::~ShmPublisher()
+{
+  queue.replace(Msg());
+  thread.join();
+
+  header->state.store(SHM_CLOSED, std::memory_order_release);
+}
+
+void ShmPublisher::add(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info)
+{
+  if (model)
+  {
+    Msg msg;
+    msg.model=model;
+    msg.info=info;
+
+    queue.replace(msg);
+  }
+}
+
+void ShmPublisher::run()
+{
+  while (true)
+  {
+    Msg msg=queue.pop();
+
+    if (!msg.model)
+    {
+      break;
+    }
+
+    gvr::ColoredMesh *mesh=dynamic_cast<gvr::ColoredMesh *>(msg.model.get());
+
+    if (mesh)
+    {
+      write(*mesh, msg.info);
+    }
+  }
+}
+
+void ShmPublisher::write(const gvr::ColoredMesh &mesh, const FrameInfo &info)
+{
+  uint64_t vn=static_cast<uint64_t>(mesh.getVertexCount());
+  uint64_t tn=static_cast<uint64_t>(mesh.getTriangleCount());
+
+  if (vn > header->max_vertices || tn > header->max_triangles)
+  {
+    if (!reported)
+    {
+      std::cerr << "Mesh too large for shared memory, " << vn << " vertices" << std::endl;
+      reported=true;
+    }
+
+    return;
+  }
+
+  // invalidate the slot before writing into it
+
+  uint64_t n=count+1;
+  uint8_t *slot=shm.getData()+sizeof(ShmHeader)+((n-1)%header->nslots)*header->slot_size;
+  ShmFrame *frame=reinterpret_cast<ShmFrame *>(slot);
+
+  frame->number.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  frame->timestamp=info.timestamp;
+  frame->grabbed=info.grabbed;
+  frame->published=gutil::ProcTime::monotonic();
+  frame->vertex_count=static_cast<uint32_t>(vn);
+  frame->triangle_count=static_cast<uint32_t>(tn);
+  frame->vertex_offset=align(sizeof(ShmFrame));
+  frame->color_offset=frame->vertex_offset+align(12*header->max_vertices);
+  frame->index_offset=frame->color_offset+align(3*header->max_vertices);
+  memset(frame->reserved, 0, sizeof(frame->reserved));
+
+  float *vertex=reinterpret_cast<float *>(slot+frame->vertex_offset);
+  uint8_t *color=slot+frame->color_offset;
+
+  for (int i=0; i<static_cast<int>(vn); i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      *vertex++=mesh.getVertexComp(i, k);
+      *color++=static_cast<uint8_t>(mesh.getColorComp(i, k));
+    }
+  }
+
+  uint32_t *index=reinterpret_cast<uint32_t *>(slot+frame->index_offset);
+
+  for (int i=0; i<static_cast<int>(tn); i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      *index++=static_cast<uint32_t>(mesh.getTriangleIndex(i, k));
+    }
+  }
+
+  // make the frame visible to readers
+
+  frame->number.store(n, std::memory_order_release);
+  header->latest.store(n, std::memory_order_release);
+
+  count=n;
+}
+
+}
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SHMPUBLISHER
+#define RC_GENICAM_VIEWER_SHMPUBLISHER
+
+#include "sink.h"
+#include "shmmesh.h"
+#include "sharedmemory.h"
+#include "boundedqueue.h"
+
+#include <gvr/coloredmesh.h>
+#include <gutil/thread.h>
+
+#include <memory>
+#include <string>
+
+namespace rcgv
+{
+
+/**
+  Publishes the latest meshes in shared memory for other processes on the
+  same host, which can read them with ShmReader. The layout is described in
+  shmmesh.h. Meshes are written in a background thread. If writing is slower
+  than the modeler, then only the latest mesh is written.
+*/
+
+class ShmPublisher: public Sink, public gutil::ThreadFunction
+{
+  public:
+
+    /**
+      Creates the shared memory segment and starts the background thread. An
+      IOException is thrown if the segment cannot be created.
+
+      @param name         Name of shared memory segment.
+      @param nslots       Number of frames that are kept.
+      @param max_vertices Maximum number of vertices of a mesh. Larger meshes
+                          are not published. The number of triangles is
+                          limited to twice this number.
+    */
+
+    ShmPublisher(const std::string &name=SHM_DEFAULT_NAME, int nslots=4,
+                 uint64_t max_vertices=1280*960);
+
+    /**
+      Stops the background thread and removes the segment. Readers that
+      still have the segment opened see it as closed.
+    */
+
+    ~ShmPublisher();
+
+    void add(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info);
+
+    void run();
+
+  private:
+
+    ShmPublisher(const ShmPublisher &);
+    ShmPublisher &operator=(const ShmPublisher &);
+
+    struct Msg
+    {
+      std::shared_ptr<gvr::Model> model;
+      FrameInfo info;
+    };
+
+    void write(const gvr::ColoredMesh &mesh, const FrameInfo &info);
+
+    std::string name;
+    SharedMemory shm;
+    ShmHeader *header;
+    uint64_t count;
+    bool reported;
+
+    BoundedQueue<Msg> queue;
+    gutil::Thread thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shmreader.h"
+
+#include <cstring>
+
+namespace rcgv
+{
+
+ShmReader::ShmReader(const std::string &_name)
+{
+  name=_name;
+  header=0;
+  latest=0;
+}
+
+bool ShmReader::getLatest(ShmFrameView &view, uint64_t last)
+{
+  // a crashed publisher leaves the segment active, so that a segment without
+  // new frames is checked for being replaced by a restarted publisher
+
+  std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+
+  if (header != 0 && now-tlatest > std::chrono::seconds(1))
+  {
+    tlatest=now;
+
+    if (!shm.isCurrent())
+    {
+      header=0;
+    }
+  }
+
+  if ((header == 0 || header->state.load(std::memory_order_acquire) != SHM_ACTIVE) &&
+      !open())
+  {
+    return false;
+  }
+
+  uint64_t n=header->latest.load(std::memory_order_acquire);
+
+  if (n != latest)
+  {
+    latest=n;
+    tlatest=now;
+  }
+
+  if (n == 0 || n == last)
+  {
+    return false;
+  }
+
+  const uint8_t *slot=shm.getData()+sizeof(ShmHeader)+((n-1)%header->nslots)*header->slot_size;
+  const ShmFrame *frame=reinterpret_cast<const ShmFrame *>(slot);
+
+  if (frame->number.load(std::memory_order_acquire) != n)
+  {
+    return false; // overwritten already
+  }
+
+  view.number=n;
+  view.timestamp=frame->timestamp;
+  view.grabbed=frame->grabbed;
+  view.published=frame->published;
+  view.vertex_count=frame->vertex_count;
+  view.triangle_count=frame->triangle_count;
+  view.vertex=reinterpret_cast<const float *>(slot+frame->vertex_offset);
+  view.color=slot+frame->color_offset;
+  view.index=reinterpret_cast<const uint32_t *>(slot+frame->index_offset);
+  view.frame=frame;
+
+  // the fields must be consistent with the frame number and all arrays must
+  // be inside the slot
+
+  uint64_t size=header->slot_size;
+
+  if (!isValid(view) || view.vertex_count > header->max_vertices ||
+      view.triangle_count > header->max_triangles ||
+      frame->vertex_offset+12*static_cast<uint64_t>(view.vertex_count) > size ||
+      frame->color_offset+3*static_cast<uint64_t>(view.vertex_count) > size ||
+      frame->index_offset+12*static_cast<uint64_t>(view.triangle_count) > size)
+  {
+    view=ShmFrameView();
+    return false;
+  }
+
+  return true;
+}
+
+bool ShmReader::isValid(const ShmFrameView &view) const
+{
+  if (view.frame == 0)
+  {
+    return false;
+  }
+
+  // all reads of the data must happen before reading the number again
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return view.frame->number.load(std::memory_order_relaxed) == view.number;
+}
+
+bool ShmReader::open()
+{
+  header=0;
+
+  if (!shm.open(name))
+  {
+    return false;
+  }
+
+  // check that the segment is complete and compatible
+
+  const ShmHeader *h=reinterpret_cast<const ShmHeader *>(shm.getData());
+
+  if (shm.getSize() < sizeof(ShmHeader) || strncmp(h->magic, "RCGVSHM1", 8) != 0 ||
+      h->version != SHM_VERSION || h->byteorder != SHM_BYTEORDER || h->nslots == 0 ||
+      h->state.load(std::memory_order_acquire) != SHM_ACTIVE ||
+      shm.getSize() < sizeof(ShmHeader)+h->nslots*h->slot_size)
+  {
+    shm.close();
+    return false;
+  }
+
+  header=h;
+  latest=0;
+  tlatest=std::chrono::steady_clock::now();
+
+  return true;
+}
+
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SHMREADER
+#define RC_GENICAM_VIEWER_SHMREADER
+
+#include "shmmesh.h"
+#include "sharedmemory.h"
+
+#include <cstdint>
+#include <string>
+#include <chrono>
+
+namespace rcgv
+{
+
+/**
+  View of a frame in shared memory. The pointers refer directly to the
+  shared memory and are only valid as long as ShmReader::isValid() returns
+  true.
+*/
+
+struct ShmFrameView
+{
+  ShmFrameView() : number(0), timestamp(0), grabbed(0), published(0), vertex_count(0),
+    triangle_count(0), vertex(0), color(0), index(0), frame(0) { }
+
+  uint64_t number;          // frame number
+  uint64_t timestamp;       // timestamp of the disparity image in ns
+  double grabbed;           // monotonic host time of grabbing in s
+  double published;         // monotonic host time of publishing in s
+  uint32_t vertex_count;
+  uint32_t triangle_count;
+  const float *vertex;      // x, y, z per vertex in camera coordinates in m
+  const uint8_t *color;     // r, g, b per vertex
+  const uint32_t *index;    // three vertex indices per triangle
+
+  const ShmFrame *frame;    // slot of the frame
+};
+
+/**
+  Reader of meshes that are published in shared memory by gc_3dviewer.
+  Readers never block the publisher and do not copy any data. The reader
+  only depends on the standard library, so that it can be linked to other
+  programs.
+
+  Example:
+
+  ShmReader reader;
+  ShmFrameView view;
+
+  while (...)
+  {
+    if (reader.getLatest(view, view.number))
+    {
+      ... use view.vertex, view.color and view.index ...
+
+      if (!reader.isValid(view))
+      {
+        ... discard results, since the frame has been overwritten ...
+      }
+    }
+  }
+*/
+
+class ShmReader
+{
+  public:
+
+    /**
+      Creates the reader. The segment is opened on demand.
+
+      @param name Name of shared memory segment.
+    */
+
+    ShmReader(const std::string &name=SHM_DEFAULT_NAME);
+
+    /**
+      Returns the latest frame if it is newer than the given one. The
+      segment is opened, or opened again if the publisher has been
+      restarted, if necessary. If no new frame arrived for a second, it is
+      checked that the segment has not been replaced by a restarted
+      publisher, e.g. after a crash of the previous one.
+
+      @param view Returned view of the frame.
+      @param last Number of the last frame that has been used or 0.
+      @return     True if a newer frame has been returned.
+    */
+
+    bool getLatest(ShmFrameView &view, uint64_t last=0);
+
+    /**
+      Returns true if the frame of the view has not been overwritten yet.
+      This must be checked after using the data of the view.
+    */
+
+    bool isValid(const ShmFrameView &view) const;
+
+    /**
+      Returns true if the segment is currently open.
+    */
+
+    bool isOpen() const { return header != 0; }
+
+  private:
+
+    ShmReader(const ShmReader &);
+    ShmReader &operator=(const ShmReader &);
+
+    bool open();
+
+    std::string name;
+    SharedMemory shm;
+    const ShmHeader *header;
+
+    uint64_t latest;
+    std::chrono::steady_clock::time_point tlatest;
+};
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simdevice.h"
+
+#include <rc_genicam_api/pixel_formats.h>
+
+namespace rcgv
+{
+
+SimConfig::SimConfig()
+{
+  rate=25;
+  width=1280;
+  height=960;
+  format=Mono8;
+  multipart=false;
+  latency=2;
+  jitter=0;
+  reorder=0;
+  incomplete=0;
+  drop=0;
+  alternate=false;
+  chunk=true;
+  seed=1;
+}
+
+SimDevice::SimDevice(const SimConfig &_config) : config(_config), rng(_config.seed)
+{
+  t0=1000000000ull;
+  period=static_cast<uint64_t>(1e9/config.rate+0.5);
+  frame=0;
+}
+
+void SimDevice::grab(SimBuffer &buffer)
+{
+  while (pending.size() == 0)
+  {
+    generate();
+  }
+
+  buffer=pending.front();
+  pending.pop_front();
+
+  // remember which images have been delivered completely
+
+  if (!buffer.incomplete)
+  {
+    for (size_t i=0; i<buffer.part.size(); i++)
+    {
+      uint64_t k=getFrameNumber(buffer.part[i].image->getTimestampNS());
+
+      if (k >= delivered.size())
+      {
+        delivered.resize(k+1, 0);
+      }
+
+      delivered[k]|=(buffer.part[i].component == Synchronizer::INTENSITY ? 1 : 2);
+    }
+  }
+}
+
+uint64_t SimDevice::getFrameNumber(uint64_t timestamp)
+{
+  if (timestamp+period/2 < t0)
+  {
+    return 0;
+  }
+
+  return (timestamp+period/2-t0)/period;
+}
+
+uint64_t SimDevice::getCompletePairs()
+{
+  uint64_t ret=0;
+
+  for (size_t k=0; k<delivered.size(); k++)
+  {
+    if (config.alternate)
+    {
+      // disparity images can be paired with the intensity image of one of
+      // the neighbouring frames
+
+      if ((delivered[k]&2) && ((k > 0 && (delivered[k-1]&1)) ||
+          (k+1 < delivered.size() && (delivered[k+1]&1))))
+      {
+        ret++;
+      }
+    }
+    else if (delivered[k] == 3)
+    {
+      ret++;
+    }
+  }
+
+  return ret;
+}
+
+void SimDevice::generate()
+{
+  uint64_t timestamp=t0+frame*period;
+
+  bool has_left=(!config.alternate || (frame&1) == 1) && random() >= config.drop;
+  bool has_disp=(!config.alternate || (frame&1) == 0) && random() >= config.drop;
+
+  // disparity images are computed and delivered later
+
+  if (config.multipart)
+  {
+    if (has_left || has_disp)
+    {
+      Delayed d;
+      d.due=frame+config.latency;
+      d.buffer.incomplete=(random() < config.incomplete);
+
+      if (has_left) d.buffer.part.push_back(createPart(Synchronizer::INTENSITY, timestamp));
+      if (has_disp) d.buffer.part.push_back(createPart(Synchronizer::DISPARITY, timestamp));
+
+      delayed.push_back(d);
+    }
+  }
+  else
+  {
+    if (has_left)
+    {
+      SimBuffer b;
+      b.incomplete=(random() < config.incomplete);
+      b.part.push_back(createPart(Synchronizer::INTENSITY, timestamp));
+      pending.push_back(b);
+    }
+
+    if (has_disp)
+    {
+      Delayed d;
+      d.due=frame+config.latency;
+      d.buffer.incomplete=(random() < config.incomplete);
+      d.buffer.part.push_back(createPart(Synchronizer::DISPARITY, timestamp));
+      delayed.push_back(d);
+    }
+  }
+
+  while (delayed.size() > 0 && delayed.front().due <= frame)
+  {
+    pending.push_back(delayed.front().buffer);
+    delayed.pop_front();
+  }
+
+  // deliver out of order
+
+  if (pending.size() >= 2 && random() < config.reorder)
+  {
+    std::swap(pending[pending.size()-2], pending[pending.size()-1]);
+  }
+
+  frame++;
+}
+
+SimPart SimDevice::createPart(Synchronizer::Component component, uint64_t timestamp)
+{
+  SimPart ret;
+  ret.component=component;
+
+  if (config.chunk)
+  {
+    ret.out1_mode=(config.alternate ? "ExposureAlternateActive" : "Low");
+  }
+
+  std::shared_ptr<RawImage> image;
+
+  if (component == Synchronizer::INTENSITY)
+  {
+    image=std::make_shared<RawImage>(config.width, config.height, config.format);
+  }
+  else
+  {
+    image=std::make_shared<RawImage>(config.width/2, config.height/2, Coord3D_C16);
+
+    // jitter of timestamps between both components
+
+    if (config.jitter > 0)
+    {
+      int64_t j=static_cast<int64_t>(1e9*config.jitter*(2*random()-1));
+      timestamp=static_cast<uint64_t>(static_cast<int64_t>(timestamp)+j);
+    }
+  }
+
+  image->setTimestampNS(timestamp);
+  ret.image=image;
+
+  return ret;
+}
+
+double SimDevice::random()
+{
+  return std::uniform_real_distribution<double>(0, 1)(rng);
+}
+
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SIMDEVICE
+#define RC_GENICAM_VIEWER_SIMDEVICE
+
+#include "synchronizer.h"
+#include "rawimage.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Parameters of the simulated device.
+*/
+
+struct SimConfig
+{
+  SimConfig();
+
+  double rate;          // frame rate of the camera in Hz
+  size_t width;         // size of intensity images, disparity images have half size
+  size_t height;
+  uint64_t format;      // pixel format of intensity images
+  bool multipart;       // true for delivering both components in one buffer
+  int latency;          // number of frames that disparity images are delivered later
+  double jitter;        // maximum deviation of disparity timestamps in s
+  double reorder;       // probability of swapping a buffer with its predecessor
+  double incomplete;    // probability of an incomplete buffer
+  double drop;          // probability of losing an image
+  bool alternate;       // exposure alternate mode, i.e. intensity images are only
+                        // delivered for odd and disparity images for even frames
+  bool chunk;           // true if the out1 mode is reported in the chunk data
+  unsigned int seed;    // seed for random numbers
+};
+
+/**
+  Part of a simulated buffer.
+*/
+
+struct SimPart
+{
+  Synchronizer::Component component;
+  std::string out1_mode;
+  std::shared_ptr<const RawImage> image;
+};
+
+/**
+  Simulated buffer, which may contain one or more parts.
+*/
+
+struct SimBuffer
+{
+  bool incomplete;
+  std::vector<SimPart> part;
+};
+
+/**
+  Stand-in for a device that delivers intensity and disparity images as
+  buffers like a GenICam stream, but without any timing, i.e. as fast as they
+  are requested. The conditions of real devices, like the latency of
+  disparity images, jitter of timestamps, out of order delivery, incomplete
+  buffers and gaps in exposure alternate mode, can be configured.
+*/
+
+class SimDevice
+{
+  public:
+
+    SimDevice(const SimConfig &config);
+
+    /**
+      Returns the next buffer in the order of delivery.
+    */
+
+    void grab(SimBuffer &buffer);
+
+    /**
+      Returns the number of the frame to which the given timestamp belongs.
+    */
+
+    uint64_t getFrameNumber(uint64_t timestamp);
+
+    /**
+      Returns the number of pairs that have been delivered completely so far
+      and that should therefore be found by synchronization.
+    */
+
+    uint64_t getCompletePairs();
+
+  private:
+
+    SimDevice(const SimDevice &);
+    SimDevice &operator=(const SimDevice &);
+
+    void generate();
+    SimPart createPart(Synchronizer::Component component, uint64_t timestamp);
+    double random();
+
+    SimConfig config;
+    uint64_t t0, period;
+    uint64_t frame;
+
+    std::mt19937 rng;
+
+    struct Delayed
+    {
+      uint64_t due;
+      SimBuffer buffer;
+    };
+
+    std::deque<Delayed> delayed;
+    std::deque<SimBuffer> pending;
+
+    // bit 0 and 1 are set if intensity and disparity image of a frame have
+    // been delivered completely
+
+    std::vector<uint8_t> delivered;
+};
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SOURCE
+#define RC_GENICAM_VIEWER_SOURCE
+
+#include "recorder.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Interface of objects that provide synchronized intensity and disparity
+  images to the modeler in a background thread, like a device or a recording.
+  Parameters that are not available are reported as not readable.
+*/
+
+class Source
+{
+  public:
+
+    virtual ~Source() { }
+
+    /**
+      Returns true if the background thread is running.
+    */
+
+    virtual bool isRunning()=0;
+
+    /**
+      Stop background thread and free all resources.
+    */
+
+    virtual void close()=0;
+
+    /**
+      Sets the recorder that gets all synchronized images in addition to the
+      modeler.
+
+      @param recorder Recorder or null pointer for stopping recording.
+    */
+
+    virtual void setRecorder(const std::shared_ptr<Recorder> &recorder)=0;
+
+    /**
+      Tests if parameter is writable.
+
+      @param writable Return value that is set to true if parameter is writable
+                      and false if it is only readable.
+      @param name     Name of parameter.
+      @return         True if parameter exists and is readable.
+    */
+
+    virtual bool getWritable(bool &writable, const char *name)=0;
+
+    /**
+      Get value of boolean GenICam parameter.
+
+      @param name Name of parameter.
+      @return     Value of parameter.
+    */
+
+    virtual bool getBoolean(const char *name)=0;
+
+    /**
+      Set value of boolean GenICam parameter.
+
+      @param name  Name of parameter.
+      @param value Value of parameter.
+    */
+
+    virtual void setBoolean(const char *name, bool value)=0;
+
+    /**
+      Get value of enum GenICam parameter.
+
+      @param name Name of parameter.
+      @param list List of all enums.
+      @return     Current value of parameter.
+    */
+
+    virtual std::string getEnum(const char *name, std::vector<std::string> &list)=0;
+
+    /**
+      Set value of enum GenICam parameter.
+
+      @param name  Name of parameter.
+      @param value Current value of parameter.
+    */
+
+    virtual void setEnum(const char *name, const std::string &value)=0;
+};
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamclient.h"
+#include "streamsocket.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace rcgv
+{
+
+StreamClient::StreamClient()
+{
+  fd=-1;
+}
+
+StreamClient::~StreamClient()
+{
+  close();
+}
+
+bool StreamClient::connect(const std::string &address)
+{
+  close();
+  fd=connectSocket(address);
+
+  return fd >= 0;
+}
+
+void StreamClient::close()
+{
+  if (fd >= 0)
+  {
+    ::close(fd);
+    fd=-1;
+  }
+}
+
+bool StreamClient::receive(std::vector<uint8_t> &data)
+{
+  if (data.size() < STREAM_HEADER_SIZE)
+  {
+    data.resize(STREAM_HEADER_SIZE);
+  }
+
+  if (!read(data.data(), STREAM_HEADER_SIZE))
+  {
+    return false;
+  }
+
+  // the size is limited, so that a corrupt header cannot cause allocating
+  // up to 4 GB
+
+  size_t size=getFrameSize(data.data());
+
+  if (size == 0)
+  {
+    close();
+    return false;
+  }
+
+  data.resize(size);
+
+  return read(data.data()+STREAM_HEADER_SIZE, size-STREAM_HEADER_SIZE);
+}
+
+bool StreamClient::receive(StreamFrame &frame)
+{
+  return receive(buffer) && decodeFrame(frame, buffer.data(), buffer.size());
+}
+
+bool StreamClient::read(uint8_t *p, size_t n)
+{
+  while (n > 0 && fd >= 0)
+  {
+    ssize_t k=recv(fd, p, n, 0);
+
+    if (k > 0)
+    {
+      p+=k;
+      n-=static_cast<size_t>(k);
+    }
+    else if (k == 0 || errno != EINTR)
+    {
+      close();
+    }
+  }
+
+  return n == 0;
+}
+
+}
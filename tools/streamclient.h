@@ -0,0 +1,105 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_STREAMCLIENT
+#define RC_GENICAM_VIEWER_STREAMCLIENT
+
+#include "streamcodec.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Client for point clouds that are streamed by gc_3dviewer. The client only
+  depends on the standard library, so that it can be linked to other
+  programs.
+*/
+
+class StreamClient
+{
+  public:
+
+    StreamClient();
+    ~StreamClient();
+
+    /**
+      Connects to the server.
+
+      @param address Address as described in streamsocket.h.
+      @return        False if the connection cannot be established.
+    */
+
+    bool connect(const std::string &address);
+
+    void close();
+
+    /**
+      Receives the next encoded frame. This blocks until a complete frame is
+      available.
+
+      @param data Encoded frame, including header. The vector is only resized
+                  if necessary.
+      @return     False if the connection has been closed or the data is
+                  not valid. The connection is closed if the header is not
+                  valid or announces a frame that is larger than possible
+                  for STREAM_MAX_POINTS points.
+    */
+
+    bool receive(std::vector<uint8_t> &data);
+
+    /**
+      Receives and decodes the next frame.
+    */
+
+    bool receive(StreamFrame &frame);
+
+  private:
+
+    StreamClient(const StreamClient &);
+    StreamClient &operator=(const StreamClient &);
+
+    bool read(uint8_t *p, size_t n);
+
+    int fd;
+    std::vector<uint8_t> buffer;
+};
+
+}
+
+#endif
@@ -0,0 +1,442 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamcodec.h"
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace rcgv
+{
+
+namespace
+{
+
+void putU16(uint8_t *p, uint16_t v)
+{
+  p[0]=static_cast<uint8_t>(v);
+  p[1]=static_cast<uint8_t>(v>>8);
+}
+
+void putU32(uint8_t *p, uint32_t v)
+{
+  for (int i=0; i<4; i++)
+  {
+    p[i]=static_cast<uint8_t>(v>>(8*i));
+  }
+}
+
+void putU64(uint8_t *p, uint64_t v)
+{
+  for (int i=0; i<8; i++)
+  {
+    p[i]=static_cast<uint8_t>(v>>(8*i));
+  }
+}
+
+void putFloat(uint8_t *p, float v)
+{
+  uint32_t u;
+  memcpy(&u, &v, 4);
+  putU32(p, u);
+}
+
+uint16_t getU16(const uint8_t *p)
+{
+  return static_cast<uint16_t>(p[0] | (p[1]<<8));
+}
+
+uint32_t getU32(const uint8_t *p)
+{
+  uint32_t ret=0;
+
+  for (int i=3; i>=0; i--)
+  {
+    ret=(ret<<8) | p[i];
+  }
+
+  return ret;
+}
+
+uint64_t getU64(const uint8_t *p)
+{
+  uint64_t ret=0;
+
+  for (int i=7; i>=0; i--)
+  {
+    ret=(ret<<8) | p[i];
+  }
+
+  return ret;
+}
+
+float getFloat(const uint8_t *p)
+{
+  uint32_t u=getU32(p);
+  float ret;
+  memcpy(&ret, &u, 4);
+  return ret;
+}
+
+size_t getColorSize(int flags)
+{
+  switch (flags & STREAM_COLOR_MASK)
+  {
+    case STREAM_RGB565:
+      return 2;
+
+    case STREAM_GRAY8:
+      return 1;
+
+    default:
+      return 0;
+  }
+}
+
+}
+
+int getStreamFlags(const std::string &name)
+{
+  std::string color=name;
+  int ret=0;
+
+  size_t k=name.find('+');
+  if (k != std::string::npos)
+  {
+    if (name.substr(k+1) != "delta")
+    {
+      return -1;
+    }
+
+    color=name.substr(0, k);
+    ret|=STREAM_DELTA;
+  }
+
+  if (color == "rgb565")
+  {
+    ret|=STREAM_RGB565;
+  }
+  else if (color == "gray8")
+  {
+    ret|=STREAM_GRAY8;
+  }
+  else if (color != "none")
+  {
+    return -1;
+  }
+
+  return ret;
+}
+
+std::string getStreamFlagsName(int flags)
+{
+  std::string ret;
+
+  switch (flags & STREAM_COLOR_MASK)
+  {
+    case STREAM_RGB565:
+      ret="rgb565";
+      break;
+
+    case STREAM_GRAY8:
+      ret="gray8";
+      break;
+
+    default:
+      ret="none";
+      break;
+  }
+
+  if (flags & STREAM_DELTA)
+  {
+    ret+="+delta";
+  }
+
+  return ret;
+}
+
+void encodeFrame(std::vector<uint8_t> &out, const float *xyz, const uint8_t *rgb, size_t n,
+                 uint64_t number, uint64_t timestamp, int flags)
+{
+  // determine origin and scale from the bounding box
+
+  float vmin[3]={0, 0, 0};
+  float vmax[3]={0, 0, 0};
+
+  for (size_t i=0; i<n; i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      float v=xyz[3*i+k];
+
+      if (i == 0 || v < vmin[k]) vmin[k]=v;
+      if (i == 0 || v > vmax[k]) vmax[k]=v;
+    }
+  }
+
+  float scale[3];
+  for (int k=0; k<3; k++)
+  {
+    scale[k]=(vmax[k] > vmin[k] ? (vmax[k]-vmin[k])/65535.0f : 1.0f);
+  }
+
+  // reserve the maximum size, variable length integers need up to 3 bytes
+
+  size_t csize=getColorSize(flags);
+  size_t vsize=((flags & STREAM_DELTA) ? 3*3 : 3*2);
+
+  if (out.size() < STREAM_HEADER_SIZE+n*(vsize+csize))
+  {
+    out.resize(STREAM_HEADER_SIZE+n*(vsize+csize));
+  }
+
+  uint8_t *p=out.data()+STREAM_HEADER_SIZE;
+
+  // quantize coordinates
+
+  int prev[3]={0, 0, 0};
+
+  for (size_t i=0; i<n; i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      float q=std::floor((xyz[3*i+k]-vmin[k])/scale[k]+0.5f);
+      int v=static_cast<int>(std::max(0.0f, std::min(65535.0f, q)));
+
+      if (flags & STREAM_DELTA)
+      {
+        int d=v-prev[k];
+        uint32_t z=(d >= 0 ? static_cast<uint32_t>(d)<<1 : (static_cast<uint32_t>(-d)<<1)-1);
+
+        while (z >= 0x80)
+        {
+          *p++=static_cast<uint8_t>(z | 0x80);
+          z>>=7;
+        }
+
+        *p++=static_cast<uint8_t>(z);
+
+        prev[k]=v;
+      }
+      else
+      {
+        putU16(p, static_cast<uint16_t>(v));
+        p+=2;
+      }
+    }
+  }
+
+  // encode colors
+
+  switch (flags & STREAM_COLOR_MASK)
+  {
+    case STREAM_RGB565:
+      for (size_t i=0; i<n; i++, rgb+=3)
+      {
+        putU16(p, static_cast<uint16_t>(((rgb[0]&0xf8)<<8) | ((rgb[1]&0xfc)<<3) | (rgb[2]>>3)));
+        p+=2;
+      }
+      break;
+
+    case STREAM_GRAY8:
+      for (size_t i=0; i<n; i++, rgb+=3)
+      {
+        *p++=static_cast<uint8_t>((77*rgb[0]+150*rgb[1]+29*rgb[2])>>8);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  // write header
+
+  size_t size=static_cast<size_t>(p-out.data());
+  out.resize(size);
+
+  uint8_t *h=out.data();
+
+  memcpy(h, "RCPC", 4);
+  putU16(h+4, STREAM_VERSION);
+  putU16(h+6, static_cast<uint16_t>(flags));
+  putU32(h+8, static_cast<uint32_t>(size-STREAM_HEADER_SIZE));
+  putU32(h+12, static_cast<uint32_t>(n));
+  putU64(h+16, number);
+  putU64(h+24, timestamp);
+
+  for (int k=0; k<3; k++)
+  {
+    putFloat(h+32+4*k, vmin[k]);
+    putFloat(h+44+4*k, scale[k]);
+  }
+
+  putU64(h+56, 0);
+}
+
+size_t getFrameSize(const uint8_t *header)
+{
+  if (memcmp(header, "RCPC", 4) != 0 || getU16(header+4) != STREAM_VERSION)
+  {
+    return 0;
+  }
+
+  // variable length integers need up to 3 bytes per value
+
+  size_t size=getU32(header+8);
+
+  if (getU32(header+12) > STREAM_MAX_POINTS || size > STREAM_MAX_POINTS*(3*3+2))
+  {
+    return 0;
+  }
+
+  return STREAM_HEADER_SIZE+size;
+}
+
+bool decodeFrame(StreamFrame &frame, const uint8_t *data, size_t size)
+{
+  if (size < STREAM_HEADER_SIZE || getFrameSize(data) != size)
+  {
+    return false;
+  }
+
+  frame.flags=getU16(data+6);
+  frame.count=getU32(data+12);
+  frame.number=getU64(data+16);
+  frame.timestamp=getU64(data+24);
+
+  float origin[3], scale[3];
+  for (int k=0; k<3; k++)
+  {
+    origin[k]=getFloat(data+32+4*k);
+    scale[k]=getFloat(data+44+4*k);
+  }
+
+  size_t n=frame.count;
+  size_t csize=getColorSize(frame.flags);
+  const uint8_t *p=data+STREAM_HEADER_SIZE;
+  const uint8_t *end=data+size;
+
+  // check the number of points against the payload before allocating, a
+  // variable length integer needs at least one byte
+
+  size_t payload=size-STREAM_HEADER_SIZE;
+
+  if (((frame.flags & STREAM_DELTA) && n*(3+csize) > payload) ||
+      (!(frame.flags & STREAM_DELTA) && n*(6+csize) != payload))
+  {
+    return false;
+  }
+
+  // decode coordinates
+
+  frame.xyz.resize(3*n);
+
+  int prev[3]={0, 0, 0};
+
+  for (size_t i=0; i<n; i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      int v;
+
+      if (frame.flags & STREAM_DELTA)
+      {
+        uint32_t z=0;
+        int shift=0;
+
+        do
+        {
+          if (p >= end || shift > 21)
+          {
+            return false;
+          }
+
+          z|=static_cast<uint32_t>(*p&0x7f)<<shift;
+          shift+=7;
+        }
+        while (*p++ & 0x80);
+
+        int d=((z&1) ? -static_cast<int>((z+1)>>1) : static_cast<int>(z>>1));
+        v=prev[k]+d;
+        prev[k]=v;
+      }
+      else
+      {
+        if (p+2 > end)
+        {
+          return false;
+        }
+
+        v=getU16(p);
+        p+=2;
+      }
+
+      frame.xyz[3*i+k]=origin[k]+v*scale[k];
+    }
+  }
+
+  // decode colors
+
+  if (static_cast<size_t>(end-p) != n*csize)
+  {
+    return false;
+  }
+
+  frame.rgb.resize(csize > 0 ? 3*n : 0);
+
+  for (size_t i=0; i<n && csize > 0; i++)
+  {
+    uint8_t *c=&frame.rgb[3*i];
+
+    if (csize == 2)
+    {
+      uint16_t v=getU16(p);
+      p+=2;
+
+      c[0]=static_cast<uint8_t>(((v>>11)&0x1f)*255/31);
+      c[1]=static_cast<uint8_t>(((v>>5)&0x3f)*255/63);
+      c[2]=static_cast<uint8_t>((v&0x1f)*255/31);
+    }
+    else
+    {
+      c[0]=c[1]=c[2]=*p++;
+    }
+  }
+
+  return true;
+}
+
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_STREAMCODEC
+#define RC_GENICAM_VIEWER_STREAMCODEC
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Wire format of point clouds that are streamed over sockets.
+
+  Each frame consists of a header of STREAM_HEADER_SIZE bytes and a payload.
+  All values are stored in little endian. The header contains:
+
+  offset  type      content
+  0       char[4]   magic "RCPC"
+  4       uint16    STREAM_VERSION
+  6       uint16    flags, i.e. color encoding and STREAM_DELTA
+  8       uint32    size of payload in bytes
+  12      uint32    number of points
+  16      uint64    frame number
+  24      uint64    timestamp of the disparity image in ns
+  32      float[3]  origin of the frame in camera coordinates in m
+  44      float[3]  scale of the coordinates in m
+  56      uint64    reserved, 0
+
+  The payload contains the coordinates of all points, followed by their
+  colors. Coordinates are quantized to 16 bit values q, which are relative
+  to the origin, i.e. the position is origin+q*scale for each axis. Without
+  STREAM_DELTA, the three values of each point are stored as uint16. With
+  STREAM_DELTA, the difference of each value to the value of the previous
+  point is stored as zig-zag encoded variable length integer with 7 bits
+  per byte. Points are in the order of the rows of the disparity image, so
+  that differences are mostly small.
+
+  Colors are either not stored, stored as RGB565 in one uint16 per point or
+  as 8 bit gray value per point.
+*/
+
+const uint16_t STREAM_VERSION=1;
+const size_t STREAM_HEADER_SIZE=64;
+const size_t STREAM_MAX_POINTS=size_t(1)<<24;
+
+enum StreamFlags
+{
+  STREAM_COLOR_NONE=0,
+  STREAM_RGB565=1,
+  STREAM_GRAY8=2,
+  STREAM_COLOR_MASK=3,
+  STREAM_DELTA=16
+};
+
+/**
+  Decoded point cloud.
+*/
+
+struct StreamFrame
+{
+  StreamFrame() : number(0), timestamp(0), flags(0), count(0) { }
+
+  uint64_t number;
+  uint64_t timestamp;
+  int flags;
+  size_t count;
+  std::vector<float> xyz;    // x, y, z per point in m
+  std::vector<uint8_t> rgb;  // r, g, b per point, empty without colors
+};
+
+/**
+  Converts the name of an encoding, i.e. none, gray8 or rgb565 with an
+  optional suffix +delta, into flags.
+
+  @return Flags or -1 if the name is not valid.
+*/
+
+int getStreamFlags(const std::string &name);
+
+/**
+  Returns the name of an encoding.
+*/
+
+std::string getStreamFlagsName(int flags);
+
+/**
+  Encodes a point cloud as one frame. The output is only resized if
+  necessary.
+
+  @param out       Encoded frame.
+  @param xyz       x, y, z per point.
+  @param rgb       r, g, b per point.
+  @param n         Number of points, at most STREAM_MAX_POINTS.
+  @param number    Frame number.
+  @param timestamp Timestamp in ns.
+  @param flags     Color encoding and optionally STREAM_DELTA.
+*/
+
+void encodeFrame(std::vector<uint8_t> &out, const float *xyz, const uint8_t *rgb, size_t n,
+                 uint64_t number, uint64_t timestamp, int flags);
+
+/**
+  Returns the size of the complete frame from its header or 0 if the header
+  is not valid or the frame is larger than possible for STREAM_MAX_POINTS
+  points.
+
+  @param header First STREAM_HEADER_SIZE bytes of the frame.
+*/
+
+size_t getFrameSize(const uint8_t *header);
+
+/**
+  Decodes a complete frame. The number of points in the header is checked
+  against the size of the payload before memory is allocated.
+
+  @return False if the frame is not valid.
+*/
+
+bool decodeFrame(StreamFrame &frame, const uint8_t *data, size_t size);
+
+}
+
+#endif
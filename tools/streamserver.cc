@@ -0,0 +1,376 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamserver.h"
+#include "streamsocket.h"
+
+#include <gvr/coloredmesh.h>
+#include <gutil/proctime.h>
+#include <gutil/exception.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace rcgv
+{
+
+StreamServer::StreamServer(const std::string &_address, int _flags, int _nqueue) :
+  frame_pool(4)
+{
+  flags=_flags;
+  nqueue=static_cast<size_t>(std::max(1, _nqueue));
+  stop=false;
+  count=0;
+
+  listen_fd=listenSocket(_address, address);
+
+  if (listen_fd < 0)
+  {
+    throw gutil::IOException("Cannot open socket for streaming: "+_address);
+  }
+
+  // the pipe is used for waking up the background thread
+
+  if (pipe(wake_fd) != 0)
+  {
+    ::close(listen_fd);
+    throw gutil::IOException("Cannot create pipe for streaming");
+  }
+
+  fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+  fcntl(wake_fd[0], F_SETFL, fcntl(wake_fd[0], F_GETFL) | O_NONBLOCK);
+  fcntl(wake_fd[1], F_SETFL, fcntl(wake_fd[1], F_GETFL) | O_NONBLOCK);
+
+  thread.create(*this);
+}
+
+StreamServer::~StreamServer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop=true;
+  }
+
+  wakeup();
+  thread.join();
+
+  for (size_t i=0; i<client.size(); i++)
+  {
+    ::close(client[i].fd);
+  }
+
+  ::close(listen_fd);
+  ::close(wake_fd[0]);
+  ::close(wake_fd[1]);
+
+  if (isUnixSocket(address))
+  {
+    unlink(address.c_str());
+  }
+}
+
+StreamServer::Statistics StreamServer::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(stat_mutex);
+  return stat;
+}
+
+void StreamServer::add(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info)
+{
+  // only the latest model is kept if the background thread is busy
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending=model;
+    pending_info=info;
+  }
+
+  wakeup();
+}
+
+void StreamServer::run()
+{
+  std::vector<struct pollfd> pfd;
+
+  while (true)
+  {
+    pfd.resize(2+client.size());
+
+    pfd[0].fd=wake_fd[0];
+    pfd[0].events=POLLIN;
+    pfd[1].fd=listen_fd;
+    pfd[1].events=POLLIN;
+
+    for (size_t i=0; i<client.size(); i++)
+    {
+      pfd[2+i].fd=client[i].fd;
+      pfd[2+i].events=static_cast<short>(POLLIN | (client[i].queue.size() > 0 ? POLLOUT : 0));
+    }
+
+    for (size_t i=0; i<pfd.size(); i++)
+    {
+      pfd[i].revents=0;
+    }
+
+    if (poll(pfd.data(), static_cast<nfds_t>(pfd.size()), -1) < 0 && errno != EINTR)
+    {
+      break;
+    }
+
+    // get the latest model, if any
+
+    if (pfd[0].revents & POLLIN)
+    {
+      char tmp[64];
+      while (read(wake_fd[0], tmp, sizeof(tmp)) > 0) { }
+
+      std::shared_ptr<gvr::Model> model;
+      FrameInfo info;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (stop)
+        {
+          break;
+        }
+
+        model=pending;
+        info=pending_info;
+        pending.reset();
+      }
+
+      if (model)
+      {
+        encode(model, info);
+      }
+    }
+
+    // send queued frames and close connections that have been closed by
+    // the client, which never sends anything
+
+    size_t j=0;
+    for (size_t i=0; i<client.size(); i++)
+    {
+      short ev=pfd[2+i].revents;
+      bool ok=true;
+
+      if (ev & (POLLERR | POLLHUP | POLLNVAL))
+      {
+        ok=false;
+      }
+      else if (ev & POLLIN)
+      {
+        char tmp[256];
+        ok=(recv(client[i].fd, tmp, sizeof(tmp), 0) > 0);
+      }
+
+      if (ok && client[i].queue.size() > 0)
+      {
+        ok=send(client[i]);
+      }
+
+      if (ok)
+      {
+        client[j++]=client[i];
+      }
+      else
+      {
+        ::close(client[i].fd);
+      }
+    }
+
+    client.resize(j);
+
+    // accept new connections
+
+    if (pfd[1].revents & POLLIN)
+    {
+      accept();
+    }
+
+    std::lock_guard<std::mutex> lock(stat_mutex);
+    stat.clients=client.size();
+  }
+}
+
+void StreamServer::encode(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info)
+{
+  gvr::ColoredMesh *mesh=dynamic_cast<gvr::ColoredMesh *>(model.get());
+
+  if (mesh == 0 || client.size() == 0)
+  {
+    return;
+  }
+
+  double t=gutil::ProcTime::monotonic();
+
+  // get points and colors of the mesh, triangles are not streamed
+
+  size_t n=static_cast<size_t>(mesh->getVertexCount());
+
+  xyz.resize(3*n);
+  rgb.resize(3*n);
+
+  for (size_t i=0; i<n; i++)
+  {
+    for (int k=0; k<3; k++)
+    {
+      xyz[3*i+k]=mesh->getVertexComp(static_cast<int>(i), k);
+      rgb[3*i+k]=static_cast<uint8_t>(mesh->getColorComp(static_cast<int>(i), k));
+    }
+  }
+
+  std::shared_ptr<std::vector<uint8_t> > frame=frame_pool.get();
+  encodeFrame(*frame, xyz.data(), rgb.data(), n, ++count, info.timestamp, flags);
+
+  t=gutil::ProcTime::monotonic()-t;
+
+  // queue frame for all clients and replace the newest frame of slow
+  // clients, unless it is currently being sent
+
+  uint64_t dropped=0;
+
+  for (size_t i=0; i<client.size(); i++)
+  {
+    Client &c=client[i];
+
+    if (c.queue.size() >= nqueue && (c.queue.size() > 1 || c.offset == 0))
+    {
+      c.queue.pop_back();
+      dropped++;
+    }
+
+    if (c.queue.size() < nqueue)
+    {
+      c.queue.push_back(frame);
+    }
+    else
+    {
+      dropped++;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(stat_mutex);
+  stat.encoded++;
+  stat.dropped+=dropped;
+  stat.bytes+=frame->size();
+  stat.encode_time+=t;
+}
+
+void StreamServer::accept()
+{
+  int fd=::accept(listen_fd, 0, 0);
+
+  if (fd >= 0)
+  {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    if (!isUnixSocket(address))
+    {
+      int on=1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+
+#ifdef SO_NOSIGPIPE
+    int on=1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    Client c;
+    c.fd=fd;
+    c.offset=0;
+
+    client.push_back(c);
+  }
+}
+
+bool StreamServer::send(Client &c)
+{
+  uint64_t sent=0;
+
+  while (c.queue.size() > 0)
+  {
+    const std::vector<uint8_t> &data=*c.queue.front();
+
+    ssize_t k=::send(c.fd, data.data()+c.offset, data.size()-c.offset, MSG_NOSIGNAL);
+
+    if (k < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+      {
+        break;
+      }
+
+      return false;
+    }
+
+    c.offset+=static_cast<size_t>(k);
+
+    if (c.offset >= data.size())
+    {
+      c.queue.pop_front();
+      c.offset=0;
+      sent++;
+    }
+  }
+
+  if (sent > 0)
+  {
+    std::lock_guard<std::mutex> lock(stat_mutex);
+    stat.sent+=sent;
+  }
+
+  return true;
+}
+
+void StreamServer::wakeup()
+{
+  char c=0;
+  ssize_t ret=write(wake_fd[1], &c, 1);
+  (void) ret; // the pipe may be full, which is fine
+}
+
+}
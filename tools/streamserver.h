@@ -0,0 +1,160 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_STREAMSERVER
+#define RC_GENICAM_VIEWER_STREAMSERVER
+
+#include "sink.h"
+#include "streamcodec.h"
+#include "pool.h"
+
+#include <gutil/thread.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Serves the point clouds of all models to any number of clients over a TCP
+  or Unix domain socket. The wire format is described in streamcodec.h.
+
+  Models are encoded once in a background thread, which also handles all
+  connections with non-blocking sockets. Each client has a queue of a few
+  encoded frames. If a client is too slow, then the newest unsent frame is
+  replaced, so that neither the modeler nor other clients are blocked.
+*/
+
+class StreamServer: public Sink, public gutil::ThreadFunction
+{
+  public:
+
+    /**
+      Counters since start of the server.
+    */
+
+    struct Statistics
+    {
+      Statistics() : clients(0), encoded(0), sent(0), dropped(0), bytes(0), encode_time(0) { }
+
+      uint64_t clients;     // currently connected clients
+      uint64_t encoded;     // encoded frames
+      uint64_t sent;        // frames that have been sent completely to a client
+      uint64_t dropped;     // frames that have been dropped for a slow client
+      uint64_t bytes;       // bytes of encoded frames
+      double encode_time;   // time for converting and encoding in s
+    };
+
+    /**
+      Opens the socket and starts the background thread. An IOException is
+      thrown if the socket cannot be opened.
+
+      @param address Address as described in streamsocket.h.
+      @param flags   Color encoding and optionally STREAM_DELTA.
+      @param nqueue  Maximum number of frames that are queued per client.
+    */
+
+    StreamServer(const std::string &address, int flags=STREAM_RGB565 | STREAM_DELTA,
+                 int nqueue=2);
+
+    /**
+      Closes all connections and stops the background thread.
+    */
+
+    ~StreamServer();
+
+    /**
+      Returns the address that is actually used, e.g. the chosen port if the
+      port was given as 0.
+    */
+
+    const std::string &getAddress() const { return address; }
+
+    Statistics getStatistics();
+
+    void add(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info);
+
+    void run();
+
+  private:
+
+    StreamServer(const StreamServer &);
+    StreamServer &operator=(const StreamServer &);
+
+    struct Client
+    {
+      int fd;
+      size_t offset;  // bytes of the first frame that have already been sent
+      std::deque<std::shared_ptr<std::vector<uint8_t> > > queue;
+    };
+
+    void encode(const std::shared_ptr<gvr::Model> &model, const FrameInfo &info);
+    void accept();
+    bool send(Client &client);
+    void wakeup();
+
+    std::string address;
+    int flags;
+    size_t nqueue;
+
+    int listen_fd;
+    int wake_fd[2];
+
+    std::mutex mutex;
+    bool stop;
+    std::shared_ptr<gvr::Model> pending;
+    FrameInfo pending_info;
+
+    uint64_t count;
+    std::vector<float> xyz;
+    std::vector<uint8_t> rgb;
+    Pool<std::vector<uint8_t> > frame_pool;
+    std::vector<Client> client;
+
+    std::mutex stat_mutex;
+    Statistics stat;
+
+    gutil::Thread thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "streamsocket.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <sstream>
+
+namespace rcgv
+{
+
+namespace
+{
+
+/*
+  Splits a TCP address into host and port. The host is the loopback
+  interface if not given.
+*/
+
+void splitAddress(const std::string &address, std::string &host, std::string &port)
+{
+  size_t k=address.rfind(':');
+
+  if (k != std::string::npos)
+  {
+    host=address.substr(0, k);
+    port=address.substr(k+1);
+  }
+  else
+  {
+    host="127.0.0.1";
+    port=address;
+  }
+}
+
+bool getUnixAddress(struct sockaddr_un &addr, const std::string &path)
+{
+  if (path.size() >= sizeof(addr.sun_path))
+  {
+    return false;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family=AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path)-1);
+
+  return true;
+}
+
+}
+
+bool isUnixSocket(const std::string &address)
+{
+  return address.find('/') != std::string::npos;
+}
+
+int listenSocket(const std::string &address, std::string &bound)
+{
+  int fd=-1;
+
+  if (isUnixSocket(address))
+  {
+    struct sockaddr_un addr;
+
+    if (!getUnixAddress(addr, address))
+    {
+      return -1;
+    }
+
+    unlink(address.c_str());
+
+    fd=socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd >= 0 && (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        listen(fd, 8) != 0))
+    {
+      close(fd);
+      fd=-1;
+    }
+
+    bound=address;
+  }
+  else
+  {
+    std::string host, port;
+    splitAddress(address, host, port);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family=AF_UNSPEC;
+    hints.ai_socktype=SOCK_STREAM;
+    hints.ai_flags=AI_PASSIVE;
+
+    struct addrinfo *res=0;
+
+    if (getaddrinfo(host.size() > 0 ? host.c_str() : 0, port.c_str(), &hints, &res) != 0)
+    {
+      return -1;
+    }
+
+    for (struct addrinfo *ai=res; ai != 0 && fd < 0; ai=ai->ai_next)
+    {
+      fd=socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+
+      if (fd >= 0)
+      {
+        int on=1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || listen(fd, 8) != 0)
+        {
+          close(fd);
+          fd=-1;
+        }
+      }
+    }
+
+    freeaddrinfo(res);
+
+    // report the port that is actually used, which matters for port 0
+
+    struct sockaddr_storage addr;
+    socklen_t len=sizeof(addr);
+
+    if (fd >= 0 && getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) == 0)
+    {
+      int p=0;
+
+      if (addr.ss_family == AF_INET)
+      {
+        p=ntohs(reinterpret_cast<struct sockaddr_in *>(&addr)->sin_port);
+      }
+      else if (addr.ss_family == AF_INET6)
+      {
+        p=ntohs(reinterpret_cast<struct sockaddr_in6 *>(&addr)->sin6_port);
+      }
+
+      std::ostringstream out;
+      out << host << ":" << p;
+      bound=out.str();
+    }
+  }
+
+  return fd;
+}
+
+int connectSocket(const std::string &address)
+{
+  int fd=-1;
+
+  if (isUnixSocket(address))
+  {
+    struct sockaddr_un addr;
+
+    if (!getUnixAddress(addr, address))
+    {
+      return -1;
+    }
+
+    fd=socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd >= 0 && connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      close(fd);
+      fd=-1;
+    }
+  }
+  else
+  {
+    std::string host, port;
+    splitAddress(address, host, port);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family=AF_UNSPEC;
+    hints.ai_socktype=SOCK_STREAM;
+
+    struct addrinfo *res=0;
+
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0)
+    {
+      return -1;
+    }
+
+    for (struct addrinfo *ai=res; ai != 0 && fd < 0; ai=ai->ai_next)
+    {
+      fd=socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+
+      if (fd >= 0 && connect(fd, ai->ai_addr, ai->ai_addrlen) != 0)
+      {
+        close(fd);
+        fd=-1;
+      }
+    }
+
+    freeaddrinfo(res);
+
+    if (fd >= 0)
+    {
+      int on=1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+  }
+
+  return fd;
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_STREAMSOCKET
+#define RC_GENICAM_VIEWER_STREAMSOCKET
+
+#include <string>
+
+namespace rcgv
+{
+
+/**
+  Socket addresses are given as <port> for TCP on the loopback interface, as
+  <host>:<port> for TCP on a specific interface or host, as :<port> for
+  listening on all interfaces, or as a path that contains a '/' for a Unix
+  domain socket. These functions do not throw
+  exceptions, since they are also used by the client library.
+*/
+
+/**
+  Opens a socket that listens for connections. An existing Unix domain
+  socket with the same path is replaced.
+
+  @param address Address as described above. Port 0 chooses a free port.
+  @param bound   Returns the address that is actually used.
+  @return        File descriptor or -1 on error.
+*/
+
+int listenSocket(const std::string &address, std::string &bound);
+
+/**
+  Connects to a listening socket.
+
+  @param address Address as described above.
+  @return        File descriptor or -1 on error.
+*/
+
+int connectSocket(const std::string &address);
+
+/**
+  Returns true if the address refers to a Unix domain socket.
+*/
+
+bool isUnixSocket(const std::string &address);
+
+}
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "synchronizer.h"
+
+#include <algorithm>
+
+namespace rcgv
+{
+
+Synchronizer::Synchronizer(size_t _maxbytes, size_t nslots) : left_ring(nslots),
+  disp_ring(nslots)
+{
+  maxbytes=_maxbytes;
+  bytes=0;
+  left_paired=0;
+  disp_paired=0;
+}
+
+Synchronizer::Window Synchronizer::getWindow(const std::string &out1_mode, uint64_t tol)
+{
+  // (In exposure alternate mode, rectified images are taken with projector
+  // off and disparity images with projector on. They are always around 40
+  // ms apart, before or after.)
+
+  if (out1_mode.size() > 0)
+  {
+    if (out1_mode == "ExposureAlternateActive")
+    {
+      const int64_t ALTERNATE=250*1000*1000; // maximum difference of 250 ms
+      return Window(-ALTERNATE, ALTERNATE);
+    }
+
+    return Window(0, 0);
+  }
+
+  return Window(-static_cast<int64_t>(tol), static_cast<int64_t>(tol));
+}
+
+bool Synchronizer::add(Component component, const std::shared_ptr<const RawImage> &image,
+                       const Window &window, std::shared_ptr<const RawImage> &left,
+                       std::shared_ptr<const RawImage> &disp)
+{
+  uint64_t timestamp=image->getTimestampNS();
+
+  // look for the counterpart first, so that an image that completes a pair
+  // is not stored at all
+
+  // a counterpart that is older than the last paired image of the same
+  // component is rejected, since its own partner must have been lost and
+  // pairing it would shift all following pairs by one frame if the window
+  // is large, as in exposure alternate mode
+
+  int64_t ts=static_cast<int64_t>(timestamp);
+  uint64_t paired=(component == INTENSITY ? left_paired : disp_paired);
+  Ring &other=(component == INTENSITY ? disp_ring : left_ring);
+  size_t i;
+
+  if (paired >= timestamp)
+  {
+    paired=0; // image arrived late or timestamps have been reset
+  }
+
+  if (component == INTENSITY)
+  {
+    i=find(disp_ring, std::max(paired+1,
+      static_cast<uint64_t>(std::max<int64_t>(0, ts-window.dmax))),
+      static_cast<uint64_t>(std::max<int64_t>(0, ts-window.dmin)), timestamp);
+  }
+  else
+  {
+    i=find(left_ring, std::max(paired+1,
+      static_cast<uint64_t>(std::max<int64_t>(0, ts+window.dmin))),
+      static_cast<uint64_t>(std::max<int64_t>(0, ts+window.dmax)), timestamp);
+  }
+
+  if (i < other.size())
+  {
+    // take the counterpart out of its ring and remove all images that are
+    // older than the pair as orphans, but keep newer images, which may
+    // belong to the next pair if the other component lags behind
+
+    if (component == INTENSITY)
+    {
+      left=image;
+      disp=other.at(i).image;
+    }
+    else
+    {
+      left=other.at(i).image;
+      disp=image;
+    }
+
+    bytes-=other.erase(i);
+
+    left_paired=left->getTimestampNS();
+    disp_paired=disp->getTimestampNS();
+
+    uint64_t tmin=std::min(left->getTimestampNS(), disp->getTimestampNS());
+
+    removeOld(left_ring, tmin);
+    removeOld(disp_ring, tmin);
+
+    stat.matched++;
+
+    return true;
+  }
+
+  left.reset();
+  disp.reset();
+
+  // store image and expire the oldest images if necessary
+
+  Entry e;
+  e.timestamp=timestamp;
+  e.bytes=(RawImage::getLineSize(image->getWidth(), image->getPixelFormat())+
+    image->getXPadding())*image->getHeight();
+  e.image=image;
+
+  if (e.bytes > maxbytes)
+  {
+    stat.expired++;
+    return false;
+  }
+
+  Ring &own=(component == INTENSITY ? left_ring : disp_ring);
+
+  while (own.full() || bytes+e.bytes > maxbytes)
+  {
+    Ring *ring=&own;
+
+    if (!own.full())
+    {
+      // take the ring with the oldest image
+
+      if (own.size() == 0 || (left_ring.size() > 0 && disp_ring.size() > 0 &&
+          (component == INTENSITY ? disp_ring : left_ring).at(0).timestamp < own.at(0).timestamp))
+      {
+        ring=(component == INTENSITY ? &disp_ring : &left_ring);
+      }
+    }
+
+    bytes-=ring->popFront();
+    stat.expired++;
+  }
+
+  own.insert(e);
+  bytes+=e.bytes;
+
+  return false;
+}
+
+void Synchronizer::clear()
+{
+  left_ring.clear();
+  disp_ring.clear();
+  bytes=0;
+  left_paired=0;
+  disp_paired=0;
+}
+
+size_t Synchronizer::find(Ring &ring, uint64_t tmin, uint64_t tmax, uint64_t timestamp)
+{
+  // binary search for the first candidate and linear search for the
+  // closest one within the window, which contains only a few images
+
+  size_t ret=ring.size();
+  uint64_t dbest=0;
+
+  for (size_t i=ring.lowerBound(tmin); i<ring.size() && ring.at(i).timestamp <= tmax; i++)
+  {
+    uint64_t t=ring.at(i).timestamp;
+    uint64_t d=(t > timestamp ? t-timestamp : timestamp-t);
+
+    if (ret == ring.size() || d < dbest)
+    {
+      ret=i;
+      dbest=d;
+    }
+  }
+
+  return ret;
+}
+
+void Synchronizer::removeOld(Ring &ring, uint64_t timestamp)
+{
+  while (ring.size() > 0 && ring.at(0).timestamp < timestamp)
+  {
+    stat.orphaned++;
+    bytes-=ring.popFront();
+  }
+}
+
+void Synchronizer::Ring::insert(const Entry &e)
+{
+  // images normally arrive in the order of their timestamps, so that
+  // inserting is usually just appending
+
+  size_t i=count;
+  count++;
+
+  while (i > 0 && at(i-1).timestamp > e.timestamp)
+  {
+    at(i)=at(i-1);
+    i--;
+  }
+
+  at(i)=e;
+}
+
+size_t Synchronizer::Ring::popFront()
+{
+  Entry &e=slot[first];
+  size_t ret=e.bytes;
+
+  e.image.reset();
+  first=(first+1)%slot.size();
+  count--;
+
+  return ret;
+}
+
+size_t Synchronizer::Ring::erase(size_t i)
+{
+  // the counterpart is usually close to the front, so that moving the
+  // preceding entries is cheap
+
+  size_t ret=at(i).bytes;
+
+  while (i > 0)
+  {
+    at(i)=at(i-1);
+    i--;
+  }
+
+  at(0).bytes=ret;
+
+  return popFront();
+}
+
+size_t Synchronizer::Ring::lowerBound(uint64_t timestamp)
+{
+  size_t i=0;
+  size_t k=count;
+
+  while (i < k)
+  {
+    size_t m=(i+k)/2;
+
+    if (at(m).timestamp < timestamp)
+    {
+      i=m+1;
+    }
+    else
+    {
+      k=m;
+    }
+  }
+
+  return i;
+}
+
+void Synchronizer::Ring::clear()
+{
+  while (count > 0)
+  {
+    popFront();
+  }
+
+  first=0;
+}
+
+}
@@ -0,0 +1,193 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_SYNCHRONIZER
+#define RC_GENICAM_VIEWER_SYNCHRONIZER
+
+#include "rawimage.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Finds pairs of intensity and disparity images with corresponding
+  timestamps. Images that arrive before their counterpart are kept in two
+  ring buffers of fixed capacity that are sorted by timestamp. The memory of
+  all kept images is limited by a number of bytes. This is independent of
+  rc_genicam_api, so that it can also be used with simulated images.
+
+  Storing an image usually appends it to its ring. Finding the counterpart
+  is a binary search plus a scan of the images in the window, i.e.
+  O(log n) for n kept images.
+*/
+
+class Synchronizer
+{
+  public:
+
+    enum Component { INTENSITY, DISPARITY };
+
+    /**
+      Window of the timestamp difference of the intensity image minus the
+      disparity image in ns that is accepted for a pair.
+    */
+
+    struct Window
+    {
+      Window(int64_t _dmin=0, int64_t _dmax=0) : dmin(_dmin), dmax(_dmax) { }
+
+      int64_t dmin;
+      int64_t dmax;
+    };
+
+    /**
+      Counters of images.
+    */
+
+    struct Statistics
+    {
+      Statistics() : matched(0), expired(0), orphaned(0) { }
+
+      uint64_t matched;  // pairs that have been found
+      uint64_t expired;  // images removed for limiting memory
+      uint64_t orphaned; // images removed because a newer pair has been found
+    };
+
+    /**
+      Creates the synchronizer.
+
+      @param maxbytes Maximum number of bytes of all kept images.
+      @param nslots   Maximum number of kept images per component.
+    */
+
+    Synchronizer(size_t maxbytes=256*1024*1024, size_t nslots=128);
+
+    /**
+      Returns the window for matching timestamps according to the mode of
+      Out1 that is reported in the chunk data of an image.
+
+      @param out1_mode Value of ChunkLineSource for Out1, which may be empty if
+                       it is not available.
+      @param tol       Tolerance in ns that is used if out1_mode is empty.
+      @return          Window for matching timestamps.
+    */
+
+    static Window getWindow(const std::string &out1_mode, uint64_t tol);
+
+    /**
+      Adds an image and looks for its counterpart. If several images are in
+      the window, then the one with the closest timestamp is taken. If a pair
+      is found, then all kept images that are older than the pair are
+      removed.
+
+      @param component Component of the image.
+      @param image     Image.
+      @param window    Window for finding the counterpart.
+      @param left      Returns the intensity image of the pair.
+      @param disp      Returns the disparity image of the pair.
+      @return          True if a pair has been found.
+    */
+
+    bool add(Component component, const std::shared_ptr<const RawImage> &image,
+             const Window &window, std::shared_ptr<const RawImage> &left,
+             std::shared_ptr<const RawImage> &disp);
+
+    /**
+      Removes all kept images without counting them.
+    */
+
+    void clear();
+
+    const Statistics &getStatistics() const { return stat; }
+
+  private:
+
+    struct Entry
+    {
+      uint64_t timestamp;
+      size_t bytes;
+      std::shared_ptr<const RawImage> image;
+    };
+
+    /*
+      Ring buffer of entries sorted by timestamp.
+    */
+
+    class Ring
+    {
+      public:
+
+        Ring(size_t n) : slot(n), first(0), count(0) { }
+
+        size_t size() const { return count; }
+        Entry &at(size_t i) { return slot[(first+i)%slot.size()]; }
+        bool full() const { return count == slot.size(); }
+
+        void insert(const Entry &e);
+        size_t popFront();
+        size_t erase(size_t i);
+        size_t lowerBound(uint64_t timestamp);
+        void clear();
+
+      private:
+
+        std::vector<Entry> slot;
+        size_t first;
+        size_t count;
+    };
+
+    size_t find(Ring &ring, uint64_t tmin, uint64_t tmax, uint64_t timestamp);
+    void removeOld(Ring &ring, uint64_t timestamp);
+
+    size_t maxbytes;
+    size_t bytes;
+
+    uint64_t left_paired;
+    uint64_t disp_paired;
+
+    Ring left_ring;
+    Ring disp_ring;
+
+    Statistics stat;
+};
+
+}
+
+#endif
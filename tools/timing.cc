@@ -0,0 +1,191 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timing.h"
+
+#include <gutil/semaphore.h>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+namespace rcgv
+{
+
+namespace
+{
+
+// number of times in the rolling window of each timer
+
+const int WINDOW=1024;
+
+struct Timer
+{
+  Timer() : sem(1), n(0), next(0), total(0), sum(0) { }
+
+  gutil::Semaphore sem;
+  double t[WINDOW];
+  int n;            // number of times in window
+  int next;         // next index for storing a time
+  long total;       // number of all measured times
+  double sum;       // sum of all measured times
+};
+
+Timer *getTimers()
+{
+  // timers are never destroyed, since they can still be used by background
+  // threads or exit handlers while static objects are destroyed
+
+  static Timer *timer=new Timer[TIMING_COUNT];
+  return timer;
+}
+
+double getPercentile(const std::vector<double> &sorted, double p)
+{
+  size_t i=static_cast<size_t>(p*(sorted.size()-1)+0.5);
+  return sorted[std::min(i, sorted.size()-1)];
+}
+
+}
+
+const char *getTimingName(TimingID id)
+{
+  static const char *name[]={"grab", "sync", "handoff", "decode", "mesh", "triangles",
+    "normals", "swap", "draw"};
+
+  if (id >= 0 && id < TIMING_COUNT)
+  {
+    return name[id];
+  }
+
+  return "";
+}
+
+void addTiming(TimingID id, double t)
+{
+  Timer &timer=getTimers()[id];
+  gutil::Lock lock(timer.sem);
+
+  timer.t[timer.next]=t;
+  timer.next=(timer.next+1)%WINDOW;
+  timer.n=std::min(timer.n+1, WINDOW);
+  timer.total++;
+  timer.sum+=t;
+}
+
+int getTimingPercentiles(TimingID id, double &p50, double &p90, double &p99, double &max)
+{
+  std::vector<double> sorted;
+
+  {
+    Timer &timer=getTimers()[id];
+    gutil::Lock lock(timer.sem);
+    sorted.assign(timer.t, timer.t+timer.n);
+  }
+
+  p50=p90=p99=max=0;
+
+  if (sorted.size() > 0)
+  {
+    std::sort(sorted.begin(), sorted.end());
+
+    p50=getPercentile(sorted, 0.5);
+    p90=getPercentile(sorted, 0.9);
+    p99=getPercentile(sorted, 0.99);
+    max=sorted.back();
+  }
+
+  return static_cast<int>(sorted.size());
+}
+
+std::string getTimingSummary(TimingID first, TimingID last)
+{
+  std::ostringstream out;
+
+  out << std::fixed << std::setprecision(1) << "p50/p99 [ms]:";
+
+  for (int i=first; i<=last && i<TIMING_COUNT; i++)
+  {
+    double p50, p90, p99, max;
+
+    if (getTimingPercentiles(static_cast<TimingID>(i), p50, p90, p99, max) > 0)
+    {
+      out << " " << getTimingName(static_cast<TimingID>(i)) << " " << 1000*p50 << "/" <<
+        1000*p99;
+    }
+  }
+
+  return out.str();
+}
+
+bool writeTimings(const std::string &name)
+{
+  std::ofstream out(name.c_str());
+
+  out << "# times in ms, percentiles of the last " << WINDOW << " measurements" << std::endl;
+  out << "# " << std::left << std::setw(10) << "timer" << std::right << std::setw(10) <<
+    "count" << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" <<
+    std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+
+  for (int i=0; i<TIMING_COUNT; i++)
+  {
+    double p50, p90, p99, max;
+    getTimingPercentiles(static_cast<TimingID>(i), p50, p90, p99, max);
+
+    long total;
+    double sum;
+
+    {
+      Timer &timer=getTimers()[i];
+      gutil::Lock lock(timer.sem);
+      total=timer.total;
+      sum=timer.sum;
+    }
+
+    out << std::left << std::setw(12) << getTimingName(static_cast<TimingID>(i)) <<
+      std::right << std::fixed << std::setprecision(3) << std::setw(10) << total <<
+      std::setw(10) << (total > 0 ? 1000*sum/total : 0) << std::setw(10) << 1000*p50 <<
+      std::setw(10) << 1000*p90 << std::setw(10) << 1000*p99 << std::setw(10) <<
+      1000*max << std::endl;
+  }
+
+  out.close();
+
+  return !out.fail();
+}
+
+}
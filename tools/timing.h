@@ -0,0 +1,127 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_TIMING
+#define RC_GENICAM_VIEWER_TIMING
+
+#include <gutil/proctime.h>
+
+#include <string>
+
+namespace rcgv
+{
+
+/**
+  Timers of the hot paths of the receiver, the modeler and the viewer.
+*/
+
+enum TimingID
+{
+  TIMING_GRAB_WAIT,   // waiting for the next buffer of the stream
+  TIMING_SYNC,        // storing and synchronizing images
+  TIMING_HANDOFF,     // handing images over to the modeler
+  TIMING_DECODE,      // counting valid disparities and preparing bands
+  TIMING_MESH,        // creating colors, vertices and triangles
+  TIMING_TRIANGLES,   // storing triangles in the mesh
+  TIMING_NORMALS,     // computing normals
+  TIMING_MODEL_SWAP,  // replacing the model in the viewer
+  TIMING_DRAW,        // drawing the scene
+  TIMING_COUNT
+};
+
+/**
+  Returns a short name of the timer.
+*/
+
+const char *getTimingName(TimingID id);
+
+/**
+  Adds a measured time in seconds to the rolling window of the timer. This
+  does not allocate memory and can be called from any thread.
+*/
+
+void addTiming(TimingID id, double t);
+
+/**
+  Computes percentiles of the times in the rolling window of the timer.
+
+  @param id  Timer.
+  @param p50 Median in seconds.
+  @param p90 90th percentile in seconds.
+  @param p99 99th percentile in seconds.
+  @param max Maximum in seconds.
+  @return    Number of times in the rolling window.
+*/
+
+int getTimingPercentiles(TimingID id, double &p50, double &p90, double &p99, double &max);
+
+/**
+  Returns the medians and 99th percentiles in milliseconds of the given range
+  of timers as one line of text.
+*/
+
+std::string getTimingSummary(TimingID first, TimingID last);
+
+/**
+  Writes count, mean and percentiles of all timers as table into a file.
+
+  @return False if the file cannot be written.
+*/
+
+bool writeTimings(const std::string &name);
+
+/**
+  Measures the time from construction to destruction.
+*/
+
+class ScopedTiming
+{
+  public:
+
+    ScopedTiming(TimingID _id) : id(_id), t0(gutil::ProcTime::monotonic()) { }
+    ~ScopedTiming() { addTiming(id, gutil::ProcTime::monotonic()-t0); }
+
+  private:
+
+    ScopedTiming(const ScopedTiming &);
+    ScopedTiming &operator=(const ScopedTiming &);
+
+    TimingID id;
+    double t0;
+};
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "workers.h"
+#include "alloccount.h"
+
+#include <thread>
+#include <algorithm>
+
+namespace rcgv
+{
+
+Workers::Workers(int n)
+{
+  if (n <= 0)
+  {
+    n=std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  job=0;
+  jobn=0;
+  next=0;
+  alloc=0;
+  running=true;
+
+  for (int i=1; i<n; i++)
+  {
+    worker.push_back(std::make_shared<Worker>(*this));
+    worker.back()->thread.create(*worker.back());
+  }
+}
+
+Workers::~Workers()
+{
+  running=false;
+
+  for (size_t i=0; i<worker.size(); i++)
+  {
+    worker[i]->start.increment();
+    worker[i]->thread.join();
+  }
+}
+
+void Workers::run(int n, const std::function<void(int)> &f)
+{
+  job=&f;
+  jobn=n;
+  next=0;
+
+  // wake up only as many threads as needed
+
+  size_t m=std::min(worker.size(), static_cast<size_t>(std::max(0, n-1)));
+
+  for (size_t i=0; i<m; i++)
+  {
+    worker[i]->start.increment();
+  }
+
+  process();
+
+  for (size_t i=0; i<m; i++)
+  {
+    worker[i]->done.decrement();
+  }
+
+  job=0;
+}
+
+void Workers::process()
+{
+  int j=next++;
+  while (j < jobn)
+  {
+    (*job)(j);
+    j=next++;
+  }
+}
+
+void Workers::Worker::run()
+{
+  while (true)
+  {
+    start.decrement();
+
+    if (!parent.running)
+    {
+      break;
+    }
+
+    uint64_t a=getThreadAllocationCount();
+    parent.process();
+    parent.alloc+=getThreadAllocationCount()-a;
+
+    done.increment();
+  }
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the rc_genicam_3dviewer package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Author: Heiko Hirschmueller
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_GENICAM_VIEWER_WORKERS
+#define RC_GENICAM_VIEWER_WORKERS
+
+#include <gutil/thread.h>
+#include <gutil/semaphore.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace rcgv
+{
+
+/**
+  Pool of background threads that execute a function for a number of jobs in
+  parallel. The calling thread takes part in processing the jobs.
+*/
+
+class Workers
+{
+  public:
+
+    /**
+      Creates the worker threads.
+
+      @param n Number of threads, including the calling thread. 0 for using
+               the number of cores.
+    */
+
+    Workers(int n);
+    ~Workers();
+
+    /**
+      Returns the number of threads, including the calling thread.
+    */
+
+    int getThreadCount() const { return static_cast<int>(worker.size())+1; }
+
+    /**
+      Calls the given function for all jobs from 0 to n-1 and returns after
+      all calls have finished.
+
+      @param n Number of jobs.
+      @param f Function that is called with the job number.
+    */
+
+    void run(int n, const std::function<void(int)> &f);
+
+    /**
+      Returns the number of heap allocations that jobs made in the background
+      threads. Allocations in the calling thread are not included.
+    */
+
+    uint64_t getAllocationCount() const { return alloc; }
+
+  private:
+
+    Workers(const Workers &);
+    Workers &operator=(const Workers &);
+
+    class Worker: public gutil::ThreadFunction
+    {
+      public:
+
+        Worker(Workers &_parent) : parent(_parent) { }
+        void run();
+
+        Workers &parent;
+        gutil::Semaphore start;
+        gutil::Semaphore done;
+        gutil::Thread thread;
+    };
+
+    void process();
+
+    std::vector<std::shared_ptr<Worker> > worker;
+    std::atomic_bool running;
+
+    const std::function<void(int)> *job;
+    int jobn;
+    std::atomic_int next;
+
+    std::atomic<uint64_t> alloc;
+};
+
+}
+
+#endif